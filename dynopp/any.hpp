@@ -0,0 +1,339 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace dyno
+{
+
+constexpr std::size_t default_any_capacity = sizeof(void*) * 4;
+
+class bad_any_cast : public std::bad_cast
+{
+public:
+	const char* what() const noexcept override
+	{
+		return "bad any cast";
+	}
+};
+
+//-----------------------------------------------------------------------------
+/// Type erased value, like std::any, storing values of up to 'Capacity' bytes
+/// inside itself. Bigger (or throwing on move) values fall back to the heap.
+/// Unlike std::any it also takes move-only values, copying an any holding
+/// one throws std::logic_error.
+/// The capacity is a compile time choice, so that the payloads usually
+/// carried, e.g. strings and vectors, do not allocate a holder:
+///
+///     using any48 = dyno::basic_any<48>;
+///     using stream = dyno::basic_anystream<4, any48>;
+//-----------------------------------------------------------------------------
+template <std::size_t Capacity = default_any_capacity>
+class basic_any
+{
+	constexpr static std::size_t storage_size = Capacity < sizeof(void*) ? sizeof(void*) : Capacity;
+	using storage_t = std::aligned_storage_t<storage_size, alignof(std::max_align_t)>;
+
+	struct ops_t
+	{
+		const std::type_info& (*type)() noexcept;
+		void* (*get)(void*) noexcept;
+		void (*copy)(void* dst, const void* src);
+		void (*move)(void* dst, void* src) noexcept;
+		void (*destroy)(void*) noexcept;
+	};
+
+	template <typename T>
+	using is_inplace =
+		std::integral_constant<bool, sizeof(T) <= storage_size && alignof(T) <= alignof(storage_t) &&
+										 std::is_nothrow_move_constructible<T>::value>;
+
+	template <typename T, typename std::enable_if<std::is_copy_constructible<T>::value, int>::type = 0>
+	static void copy_construct(void* dst, const T& value)
+	{
+		::new(dst) T(value);
+	}
+
+	template <typename T, typename std::enable_if<!std::is_copy_constructible<T>::value, int>::type = 0>
+	static void copy_construct(void*, const T&)
+	{
+		throw std::logic_error("cannot copy an any holding a move-only value");
+	}
+
+	template <typename T, typename std::enable_if<std::is_copy_constructible<T>::value, int>::type = 0>
+	static T* copy_new(const T& value)
+	{
+		return new T(value);
+	}
+
+	template <typename T, typename std::enable_if<!std::is_copy_constructible<T>::value, int>::type = 0>
+	static T* copy_new(const T&)
+	{
+		throw std::logic_error("cannot copy an any holding a move-only value");
+	}
+
+	template <typename T>
+	struct inplace_ops
+	{
+		static const std::type_info& type() noexcept
+		{
+			return typeid(T);
+		}
+		static void* get(void* storage) noexcept
+		{
+			return storage;
+		}
+		static void copy(void* dst, const void* src)
+		{
+			copy_construct(dst, *static_cast<const T*>(src));
+		}
+		static void move(void* dst, void* src) noexcept
+		{
+			::new(dst) T(std::move(*static_cast<T*>(src)));
+			static_cast<T*>(src)->~T();
+		}
+		static void destroy(void* storage) noexcept
+		{
+			static_cast<T*>(storage)->~T();
+		}
+		static const ops_t* ops() noexcept
+		{
+			static const ops_t result{&type, &get, &copy, &move, &destroy};
+			return &result;
+		}
+	};
+
+	template <typename T>
+	struct heap_ops
+	{
+		static T*& ptr(void* storage) noexcept
+		{
+			return *static_cast<T**>(storage);
+		}
+		static const std::type_info& type() noexcept
+		{
+			return typeid(T);
+		}
+		static void* get(void* storage) noexcept
+		{
+			return ptr(storage);
+		}
+		static void copy(void* dst, const void* src)
+		{
+			::new(dst) T*(copy_new(*ptr(const_cast<void*>(src))));
+		}
+		static void move(void* dst, void* src) noexcept
+		{
+			::new(dst) T*(ptr(src));
+		}
+		static void destroy(void* storage) noexcept
+		{
+			delete ptr(storage);
+		}
+		static const ops_t* ops() noexcept
+		{
+			static const ops_t result{&type, &get, &copy, &move, &destroy};
+			return &result;
+		}
+	};
+
+	template <typename T>
+	using ops_for = std::conditional_t<is_inplace<T>::value, inplace_ops<T>, heap_ops<T>>;
+
+	template <typename T>
+	using is_value = std::integral_constant<bool, !std::is_same<std::decay_t<T>, basic_any>::value>;
+
+public:
+	constexpr static std::size_t capacity = storage_size;
+
+	basic_any() noexcept = default;
+	basic_any(const basic_any& rhs)
+	{
+		if(rhs.ops_)
+		{
+			rhs.ops_->copy(&storage_, &rhs.storage_);
+			ops_ = rhs.ops_;
+		}
+	}
+	basic_any(basic_any&& rhs) noexcept
+	{
+		move_from(rhs);
+	}
+	template <typename T, typename std::enable_if<is_value<T>::value, int>::type = 0>
+	basic_any(T&& value)
+	{
+		emplace(std::forward<T>(value));
+	}
+
+	basic_any& operator=(const basic_any& rhs)
+	{
+		if(this != &rhs)
+		{
+			basic_any tmp(rhs);
+			reset();
+			move_from(tmp);
+		}
+		return *this;
+	}
+	basic_any& operator=(basic_any&& rhs) noexcept
+	{
+		if(this != &rhs)
+		{
+			reset();
+			move_from(rhs);
+		}
+		return *this;
+	}
+	template <typename T, typename std::enable_if<is_value<T>::value, int>::type = 0>
+	basic_any& operator=(T&& value)
+	{
+		basic_any tmp(std::forward<T>(value));
+		reset();
+		move_from(tmp);
+		return *this;
+	}
+
+	~basic_any()
+	{
+		reset();
+	}
+
+	bool has_value() const noexcept
+	{
+		return ops_ != nullptr;
+	}
+
+	const std::type_info& type() const noexcept
+	{
+		return ops_ ? ops_->type() : typeid(void);
+	}
+
+	void reset() noexcept
+	{
+		if(ops_)
+		{
+			ops_->destroy(&storage_);
+			ops_ = nullptr;
+		}
+	}
+
+	void swap(basic_any& rhs) noexcept
+	{
+		basic_any tmp(std::move(rhs));
+		rhs = std::move(*this);
+		*this = std::move(tmp);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// The stored value if it is a T, nullptr otherwise. Values stored from the
+	/// same module are recognized by their ops alone, without comparing type_info.
+	//-----------------------------------------------------------------------------
+	template <typename T>
+	T* get() noexcept
+	{
+		if(ops_ == nullptr || !holds<T>(ops_))
+		{
+			return nullptr;
+		}
+		return static_cast<T*>(ops_->get(&storage_));
+	}
+
+	template <typename T>
+	const T* get() const noexcept
+	{
+		return const_cast<basic_any*>(this)->template get<T>();
+	}
+
+private:
+	template <typename T, typename std::enable_if<std::is_move_constructible<T>::value, int>::type = 0>
+	static bool holds(const ops_t* ops) noexcept
+	{
+		return ops == ops_for<T>::ops() || ops->type() == typeid(T);
+	}
+
+	// never stored, there are no ops to compare with
+	template <typename T, typename std::enable_if<!std::is_move_constructible<T>::value, int>::type = 0>
+	static bool holds(const ops_t* ops) noexcept
+	{
+		return ops->type() == typeid(T);
+	}
+
+	template <typename T, typename U = std::decay_t<T>>
+	void emplace(T&& value)
+	{
+		emplace_impl<U>(is_inplace<U>{}, std::forward<T>(value));
+	}
+
+	template <typename U, typename T>
+	void emplace_impl(std::true_type, T&& value)
+	{
+		::new(static_cast<void*>(&storage_)) U(std::forward<T>(value));
+		ops_ = inplace_ops<U>::ops();
+	}
+
+	template <typename U, typename T>
+	void emplace_impl(std::false_type, T&& value)
+	{
+		::new(static_cast<void*>(&storage_)) U*(new U(std::forward<T>(value)));
+		ops_ = heap_ops<U>::ops();
+	}
+
+	void move_from(basic_any& rhs) noexcept
+	{
+		if(rhs.ops_)
+		{
+			rhs.ops_->move(&storage_, &rhs.storage_);
+			ops_ = rhs.ops_;
+			rhs.ops_ = nullptr;
+		}
+	}
+
+	storage_t storage_;
+	const ops_t* ops_{nullptr};
+};
+
+template <std::size_t Capacity>
+constexpr std::size_t basic_any<Capacity>::capacity;
+
+using any = basic_any<>;
+
+template <typename T, std::size_t Capacity>
+const T* any_cast(const basic_any<Capacity>* operand) noexcept
+{
+	return operand ? operand->template get<T>() : nullptr;
+}
+
+template <typename T, std::size_t Capacity>
+T* any_cast(basic_any<Capacity>* operand) noexcept
+{
+	return operand ? operand->template get<T>() : nullptr;
+}
+
+template <typename T, std::size_t Capacity>
+T any_cast(const basic_any<Capacity>& operand)
+{
+	using value_t = std::remove_cv_t<std::remove_reference_t<T>>;
+	auto value = any_cast<value_t>(&operand);
+	if(value == nullptr)
+	{
+		throw bad_any_cast();
+	}
+	return *value;
+}
+
+// moves the value out, the way to get a move-only value back
+template <typename T, std::size_t Capacity>
+T any_cast(basic_any<Capacity>&& operand)
+{
+	using value_t = std::remove_cv_t<std::remove_reference_t<T>>;
+	auto value = any_cast<value_t>(&operand);
+	if(value == nullptr)
+	{
+		throw bad_any_cast();
+	}
+	return std::move(*value);
+}
+}
@@ -1,7 +1,10 @@
 #pragma once
+#include "delegate.hpp"
 #include "utility.hpp"
-#include <functional>
+#include <cstddef>
+#include <initializer_list>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -29,8 +32,315 @@ struct archive
 
 	template <typename T>
 	static bool unpack(iarchive_t&, T&);
+
+	// Optional. Takes over the storage instead of referring to it, so that its
+	// values can be moved out, used by call_async and object::take. Without it
+	// the storage binds to the overload above and its values are copied.
+	// static iarchive_t create_iarchive(storage_t&& storage);
+
+	// Optional. Takes back archives no longer needed so that their buffers can
+	// be reused by the next create_oarchive. Binders call it when present.
+	// static void recycle(iarchive_t&&);
+	// static void recycle(oarchive_t&&);
+
+	// Optional. A cache kept by every slot for each of its arguments and passed
+	// back to unpack, for example to remember how the previous value was converted.
+	// template <typename T>
+	// using unpack_cache_t = ...;
+	// template <typename T>
+	// static bool unpack(iarchive_t&, T&, unpack_cache_t<T>&);
+
+	// Optional. Packs the addresses of the arguments instead of copies, used by
+	// synchronous dispatches and calls only, which outlive the archive.
+	// Borrowing archives are a type of their own which get_storage must not
+	// accept, so that storing one does not compile.
+	// Slots taking const references bind to the next value through unpack_ref,
+	// borrowed or not, instead of copying it. It returns false when the value
+	// cannot be referenced as a T, and then it is unpacked as usual.
+	// using borrowed_oarchive_t = ...;
+	// static borrowed_oarchive_t create_borrowed_oarchive();
+	// static iarchive_t create_iarchive(borrowed_oarchive_t&&);
+	// template <typename... Args>
+	// static void pack_borrowed(borrowed_oarchive_t&, Args&&...);
+	// template <typename T>
+	// static bool unpack_ref(iarchive_t&, const T*&);
+
+	// Optional. Points to the next value when it is a T which can be moved from,
+	// stored by the archive or borrowed from an rvalue. Only the last reader of
+	// an archive calls it, e.g. a unicast or the last slot of a dispatch, and
+	// it moves the value straight into the parameter or the result.
+	// template <typename T>
+	// static bool unpack_movable(iarchive_t&, T*&);
+};
+
+namespace detail
+{
+template <typename Archive, typename T>
+using recycle_expression = decltype(Archive::recycle(std::declval<T>()));
+
+template <typename Archive, typename T,
+		  typename std::enable_if<hpp::is_detected<recycle_expression, Archive, T&&>::value, int>::type = 0>
+void recycle(T&& archive)
+{
+	Archive::recycle(std::move(archive));
+}
+
+template <typename Archive, typename T,
+		  typename std::enable_if<!hpp::is_detected<recycle_expression, Archive, T&&>::value, int>::type = 0>
+void recycle(T&&)
+{
+}
+
+struct no_unpack_cache
+{
+};
+
+template <typename Archive, typename T>
+using unpack_cache_expression = typename Archive::template unpack_cache_t<T>;
+
+template <typename Archive, typename T, bool = hpp::is_detected<unpack_cache_expression, Archive, T>::value>
+struct unpack_cache
+{
+	using type = no_unpack_cache;
+
+	static bool unpack(typename Archive::iarchive_t& iarchive, T& obj, type&)
+	{
+		return Archive::unpack(iarchive, obj);
+	}
+};
+
+template <typename Archive, typename T>
+struct unpack_cache<Archive, T, true>
+{
+	using type = typename Archive::template unpack_cache_t<T>;
+
+	static bool unpack(typename Archive::iarchive_t& iarchive, T& obj, type& cache)
+	{
+		return Archive::unpack(iarchive, obj, cache);
+	}
+};
+
+template <bool... Values>
+struct bool_pack;
+
+template <bool... Values>
+using all_true = std::is_same<bool_pack<true, Values...>, bool_pack<Values..., true>>;
+
+template <typename Archive, typename... Args>
+using pack_borrowed_expression = decltype(
+	Archive::pack_borrowed(std::declval<typename Archive::borrowed_oarchive_t&>(), std::declval<Args>()...));
+
+// arrays and functions decay when packed by value, they cannot be borrowed as they are
+template <typename T>
+using is_borrowable = std::is_same<std::decay_t<T>, std::remove_cv_t<std::remove_reference_t<T>>>;
+
+template <typename Archive, typename... Args>
+using can_borrow =
+	std::integral_constant<bool, hpp::is_detected<pack_borrowed_expression, Archive, Args...>::value &&
+									 all_true<is_borrowable<Args>::value...>::value>;
+
+//-----------------------------------------------------------------------------
+/// Packs the arguments of a synchronous dispatch or call, borrowing them when
+/// the archive can. Otherwise they are copied when still needed afterwards,
+/// or else moved. Only the input archive is handed out, a borrowing output
+/// archive never leaves this function.
+//-----------------------------------------------------------------------------
+template <typename Archive, typename... Args,
+		  typename std::enable_if<can_borrow<Archive, Args...>::value, int>::type = 0>
+typename Archive::iarchive_t pack_sync(bool still_needed, Args&&... args)
+{
+	auto oarchive = Archive::create_borrowed_oarchive();
+	if(still_needed)
+	{
+		Archive::pack_borrowed(oarchive, static_cast<const std::remove_reference_t<Args>&>(args)...);
+	}
+	else
+	{
+		Archive::pack_borrowed(oarchive, std::forward<Args>(args)...);
+	}
+	return Archive::create_iarchive(std::move(oarchive));
+}
+
+template <typename Archive, typename... Args,
+		  typename std::enable_if<!can_borrow<Archive, Args...>::value, int>::type = 0>
+typename Archive::iarchive_t pack_sync(bool still_needed, Args&&... args)
+{
+	auto oarchive = Archive::create_oarchive();
+	if(still_needed)
+	{
+		Archive::pack(oarchive, static_cast<const std::remove_reference_t<Args>&>(args)...);
+	}
+	else
+	{
+		Archive::pack(oarchive, std::forward<Args>(args)...);
+	}
+	return Archive::create_iarchive(std::move(oarchive));
+}
+
+template <typename Archive, typename T>
+using unpack_ref_expression = decltype(
+	Archive::unpack_ref(std::declval<typename Archive::iarchive_t&>(), std::declval<const T*&>()));
+
+template <typename Archive, typename T,
+		  typename std::enable_if<hpp::is_detected<unpack_ref_expression, Archive, T>::value, int>::type = 0>
+bool unpack_ref(typename Archive::iarchive_t& iarchive, const T*& ref)
+{
+	return Archive::unpack_ref(iarchive, ref);
+}
+
+template <typename Archive, typename T,
+		  typename std::enable_if<!hpp::is_detected<unpack_ref_expression, Archive, T>::value, int>::type = 0>
+bool unpack_ref(typename Archive::iarchive_t&, const T*&)
+{
+	return false;
+}
+
+template <typename Archive, typename T>
+using unpack_movable_expression = decltype(
+	Archive::unpack_movable(std::declval<typename Archive::iarchive_t&>(), std::declval<T*&>()));
+
+template <typename Archive, typename T,
+		  typename std::enable_if<hpp::is_detected<unpack_movable_expression, Archive, T>::value, int>::type = 0>
+bool unpack_movable(typename Archive::iarchive_t& iarchive, T*& movable)
+{
+	return Archive::unpack_movable(iarchive, movable);
+}
+
+template <typename Archive, typename T,
+		  typename std::enable_if<!hpp::is_detected<unpack_movable_expression, Archive, T>::value, int>::type = 0>
+bool unpack_movable(typename Archive::iarchive_t&, T*&)
+{
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+/// Unpacks a value from an archive read for the last time, moving it out
+/// when the archive allows it.
+//-----------------------------------------------------------------------------
+template <typename Archive, typename T>
+bool unpack_last(typename Archive::iarchive_t& iarchive, T& obj)
+{
+	T* movable = nullptr;
+	if(unpack_movable<Archive>(iarchive, movable))
+	{
+		obj = std::move(*movable);
+		return true;
+	}
+	return Archive::unpack(iarchive, obj);
+}
+
+//-----------------------------------------------------------------------------
+/// An argument unpacked for a slot parameter of type Param.
+//-----------------------------------------------------------------------------
+template <typename Archive, typename Param>
+struct unpacked_arg
+{
+	using value_t = std::decay_t<Param>;
+
+	// the last reader of the archive refers to the value to move instead of copying it
+	bool unpack(typename Archive::iarchive_t& iarchive, typename unpack_cache<Archive, value_t>::type& cache,
+				bool last)
+	{
+		return (last && unpack_movable<Archive>(iarchive, movable)) ||
+			   unpack_cache<Archive, value_t>::unpack(iarchive, value, cache);
+	}
+
+	// the value is unpacked for a single call, so by value parameters take it over
+	using result_t = std::conditional_t<std::is_lvalue_reference<Param>::value, value_t&, value_t&&>;
+
+	result_t get() noexcept
+	{
+		return static_cast<result_t>(movable != nullptr ? *movable : value);
+	}
+
+	value_t* movable{nullptr};
+	value_t value{};
+};
+
+// const references bind to the archive's value when it allows it, otherwise to a copy.
+// The archive outlives the call, so with many slots the value is not copied for each.
+template <typename Archive, typename T>
+struct unpacked_arg<Archive, const T&>
+{
+	using value_t = std::decay_t<const T&>;
+
+	bool unpack(typename Archive::iarchive_t& iarchive, typename unpack_cache<Archive, value_t>::type& cache,
+				bool /*last*/)
+	{
+		return unpack_ref<Archive>(iarchive, ref) ||
+			   unpack_cache<Archive, value_t>::unpack(iarchive, value, cache);
+	}
+
+	const value_t& get() const noexcept
+	{
+		return ref != nullptr ? *ref : value;
+	}
+
+	const value_t* ref{nullptr};
+	value_t value{};
+};
+
+template <typename Archive, typename Params>
+struct unpacked_args;
+
+template <typename Archive, typename... Params>
+struct unpacked_args<Archive, std::tuple<Params...>>
+{
+	using type = std::tuple<unpacked_arg<Archive, Params>...>;
+};
+
+// The arguments of a slot taking Params, as unpacked from an archive
+template <typename Archive, typename Params>
+using unpacked_args_t = typename unpacked_args<Archive, Params>::type;
+
+template <typename Archive, typename Tuple>
+struct unpack_caches;
+
+template <typename Archive, typename... Args>
+struct unpack_caches<Archive, std::tuple<Args...>>
+{
+	using type = std::tuple<typename unpack_cache<Archive, Args>::type...>;
 };
 
+// The caches for a tuple of arguments, empty if the archive has none
+template <typename Archive, typename Tuple>
+using unpack_caches_t = typename unpack_caches<Archive, Tuple>::type;
+
+template <typename Archive, typename... Params, typename Caches, std::size_t... Is>
+bool unpack_args(typename Archive::iarchive_t& iarchive, std::tuple<unpacked_arg<Archive, Params>...>& args,
+				 Caches& caches, bool last, std::index_sequence<Is...>)
+{
+	// unused by slots without parameters
+	(void)last;
+	bool unpacked = true;
+	// stops at the first argument which cannot be unpacked
+	(void)std::initializer_list<int>{
+		(unpacked = unpacked && std::get<Is>(args).unpack(iarchive, std::get<Is>(caches), last), 0)...};
+	return unpacked;
+}
+
+// 'last' when nothing reads the archive afterwards, so that its values can be moved
+template <typename Archive, typename... Params, typename Caches>
+bool unpack_args(typename Archive::iarchive_t& iarchive, std::tuple<unpacked_arg<Archive, Params>...>& args,
+				 Caches& caches, bool last)
+{
+	return unpack_args<Archive>(iarchive, args, caches, last, std::index_sequence_for<Params...>{});
+}
+
+template <typename F, typename Args, std::size_t... Is>
+decltype(auto) invoke_unpacked(F& f, Args& args, std::index_sequence<Is...>)
+{
+	return f(std::get<Is>(args).get()...);
+}
+
+// Calls f with the unpacked arguments
+template <typename F, typename Args>
+decltype(auto) invoke_unpacked(F& f, Args& args)
+{
+	return invoke_unpacked(f, args, std::make_index_sequence<std::tuple_size<Args>::value>{});
+}
+}
+
 template <typename Sentinel>
 struct lifetime
 {
@@ -51,5 +361,5 @@ struct lifetime<std::shared_ptr<void>>
 using slot_t = std::uint64_t;
 
 template <typename T>
-using delegate_t = std::function<T>;
+using delegate_t = inplace_delegate<T>;
 }
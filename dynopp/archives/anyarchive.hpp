@@ -2,23 +2,40 @@
 #include "../archive.h"
 #include "anystream.hpp"
 #include <hpp/utility.hpp>
+#include <vector>
 
 namespace dyno
 {
-template <>
-struct archive<anystream, anystream>
+template <std::size_t InlineArgs, typename Any>
+struct archive<basic_anystream<InlineArgs, Any>, basic_anystream<InlineArgs, Any>>
 {
-	using oarchive_t = anystream;
-	using iarchive_t = anystream;
-	using storage_t = oarchive_t::storage_t;
+	using oarchive_t = basic_anystream<InlineArgs, Any>;
+	using iarchive_t = basic_anystream<InlineArgs, Any>;
+	using storage_t = typename oarchive_t::storage_t;
+
+	// Not an oarchive_t, so that get_storage cannot be given one: the
+	// borrowed addresses only live during the dispatch.
+	struct borrowed_oarchive_t
+	{
+		oarchive_t stream;
+	};
+
 	static oarchive_t create_oarchive()
 	{
 		return {};
 	}
+	static borrowed_oarchive_t create_borrowed_oarchive()
+	{
+		return {};
+	}
 	static iarchive_t create_iarchive(oarchive_t&& oarchive)
 	{
 		return std::move(oarchive);
 	}
+	static iarchive_t create_iarchive(borrowed_oarchive_t&& oarchive)
+	{
+		return std::move(oarchive.stream);
+	}
 	static storage_t get_storage(oarchive_t&& oarchive)
 	{
 		if(oarchive.has_external_storage())
@@ -31,15 +48,45 @@ struct archive<anystream, anystream>
 	{
 		return storage;
 	}
+	static iarchive_t create_iarchive(storage_t&& storage)
+	{
+		return std::move(storage);
+	}
 	template <typename... Args>
 	static void pack(oarchive_t& oarchive, Args&&... args)
 	{
-		oarchive.internal_storage.reserve(sizeof...(Args));
+		auto& storage = oarchive.internal_storage;
+		if(storage.capacity() < sizeof...(Args))
+		{
+			// too many for the inline storage, a recycled buffer may have room
+			auto& buffers = pool();
+			if(storage.empty() && !buffers.empty())
+			{
+				storage = std::move(buffers.back());
+				buffers.pop_back();
+			}
+			storage.reserve(sizeof...(Args));
+		}
 
 		hpp::for_each(std::forward_as_tuple(std::forward<Args>(args)...),
 					  [&oarchive](auto&& arg) { oarchive << std::forward<decltype(arg)>(arg); });
 	}
 
+	//-----------------------------------------------------------------------------
+	/// Packs the addresses of the arguments instead of copies. Only for
+	/// archives unpacked before the arguments go away, which is why they are
+	/// not oarchive_t and cannot be stored.
+	//-----------------------------------------------------------------------------
+	template <typename... Args>
+	static void pack_borrowed(borrowed_oarchive_t& oarchive, Args&&... args)
+	{
+		auto& stream = oarchive.stream;
+		stream.borrowed_storage.reserve(sizeof...(Args));
+
+		hpp::for_each(std::forward_as_tuple(std::forward<Args>(args)...),
+					  [&stream](auto&& arg) { stream.borrow(std::forward<decltype(arg)>(arg)); });
+	}
+
 	template <typename T>
 	static bool unpack(iarchive_t& iarchive, T& obj)
 	{
@@ -47,9 +94,65 @@ struct archive<anystream, anystream>
 		return static_cast<bool>(iarchive);
 	}
 
+	template <typename T>
+	using unpack_cache_t = conversion_cache<T, Any>;
+
+	template <typename T>
+	static bool unpack(iarchive_t& iarchive, T& obj, unpack_cache_t<T>& cache)
+	{
+		iarchive.read(obj, cache);
+		return static_cast<bool>(iarchive);
+	}
+
+	template <typename T>
+	static bool unpack_ref(iarchive_t& iarchive, const T*& ref)
+	{
+		return iarchive.read_ref(ref);
+	}
+
+	template <typename T>
+	static bool unpack_movable(iarchive_t& iarchive, T*& movable)
+	{
+		return iarchive.read_movable(movable);
+	}
+
 	static void rewind(iarchive_t& iarchive)
 	{
 		iarchive.rewind();
 	}
+
+	//-----------------------------------------------------------------------------
+	/// Clears the archive and keeps its heap buffer, if it outgrew the inline
+	/// storage, for the next pack of this thread needing one. This way a dispatch
+	/// or a call in steady state does not allocate the storage, whatever the
+	/// number of arguments. Oversized buffers are let go.
+	//-----------------------------------------------------------------------------
+	static void recycle(oarchive_t&& archive)
+	{
+		if(archive.has_external_storage())
+		{
+			return;
+		}
+
+		archive.borrowed_storage.clear();
+		auto& storage = archive.internal_storage;
+		storage.clear();
+
+		auto& buffers = pool();
+		if(storage.is_heap() && storage.capacity() <= max_pooled_args && buffers.size() < max_pooled)
+		{
+			buffers.emplace_back(std::move(storage));
+		}
+	}
+
+private:
+	constexpr static std::size_t max_pooled = 16;
+	constexpr static std::size_t max_pooled_args = 32;
+
+	static std::vector<storage_t>& pool()
+	{
+		static thread_local std::vector<storage_t> buffers;
+		return buffers;
+	}
 };
 }
@@ -1,162 +1,404 @@
 #pragma once
+#include "../any.hpp"
+#include "../containers/small_vector.hpp"
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <hpp/any.hpp>
-#include <vector>
+#include <memory>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 
 namespace dyno
 {
+namespace detail
+{
+// converts from a value stored in an any, or from a pointer to the value itself
+template <typename To, typename Any>
+struct conversion_t
+{
+	bool (*from_any)(const Any&, To&);
+	void (*from_value)(const void*, To&);
+};
+
+template <typename To, typename Any>
+using conversion_table_t = std::unordered_map<std::type_index, conversion_t<To, Any>>;
+
+template <typename From, typename To>
+void convert_value(const void* value, To& result)
+{
+	result = static_cast<To>(*static_cast<const From*>(value));
+}
+
+template <typename From, typename To, typename Any>
+bool convert(const Any& operand, To& result)
+{
+	convert_value<From>(any_cast<From>(&operand), result);
+	return true;
+}
+
+// Convertible, From gets a direct converter
+template <typename From, typename To, typename Any,
+		  typename std::enable_if<std::is_convertible<From, To>::value>::type* = nullptr>
+void add_conversion(conversion_table_t<To, Any>& table)
+{
+	table.emplace(typeid(From), conversion_t<To, Any>{&convert<From, To, Any>, &convert_value<From, To>});
+}
+
 // Non-convertible fallback
-template <typename From, typename To,
+template <typename From, typename To, typename Any,
 		  typename std::enable_if<!std::is_convertible<From, To>::value>::type* = nullptr>
-bool implicit_cast_impl(const hpp::any& /*operand*/, To& /*result*/)
+void add_conversion(conversion_table_t<To, Any>&)
 {
-	return false;
 }
 
-// Convertible implicit cast
-template <typename From, typename To,
-		  typename std::enable_if<std::is_convertible<From, To>::value>::type* = nullptr>
-bool implicit_cast_impl(const hpp::any& operand, To& result)
+// Only a dyno::basic_any can hold move-only values
+template <typename Any>
+struct holds_move_only : std::false_type
 {
-	auto val = hpp::any_cast<From>(&operand);
-	if(val)
-	{
-		result = static_cast<To>(*val);
-		return true;
-	}
+};
 
+template <std::size_t Capacity>
+struct holds_move_only<basic_any<Capacity>> : std::true_type
+{
+};
+
+// Exact matches are copied, move-only values can only be moved out by the last reader
+template <typename To, typename std::enable_if<std::is_copy_assignable<To>::value, int>::type = 0>
+bool copy_exact(const To& value, To& result)
+{
+	result = value;
+	return true;
+}
+
+template <typename To, typename std::enable_if<!std::is_copy_assignable<To>::value, int>::type = 0>
+bool copy_exact(const To&, To&)
+{
 	return false;
 }
 
+// The types which can be implicitly cast to To, by the id of the stored type.
+template <typename To, typename Any>
+const conversion_table_t<To, Any>& conversion_table()
+{
+	static const auto table = []() {
+		// sparse, to keep the buckets short
+		conversion_table_t<To, Any> result(64);
+		add_conversion<const char*, To, Any>(result);
+		add_conversion<std::int8_t, To, Any>(result);
+		add_conversion<std::int16_t, To, Any>(result);
+		add_conversion<std::int32_t, To, Any>(result);
+		add_conversion<std::int64_t, To, Any>(result);
+		add_conversion<std::uint8_t, To, Any>(result);
+		add_conversion<std::uint16_t, To, Any>(result);
+		add_conversion<std::uint32_t, To, Any>(result);
+		add_conversion<std::uint64_t, To, Any>(result);
+		add_conversion<float, To, Any>(result);
+		add_conversion<double, To, Any>(result);
+		add_conversion<char, To, Any>(result);
+		add_conversion<unsigned char, To, Any>(result);
+		add_conversion<std::nullptr_t, To, Any>(result);
+		return result;
+	}();
+	return table;
+}
+}
+
 // Try to implicit cast an 'any' parameter to a type T
-template <typename To>
-bool try_implicit_cast(const hpp::any& operand, To& result)
+template <typename To, typename Any>
+bool try_implicit_cast(const Any& operand, To& result)
 {
-	if(implicit_cast_impl<To>(operand, result))
-	{
-		return true;
-	}
-	else if(implicit_cast_impl<const char*>(operand, result))
-	{
-		return true;
-	}
-	else if(implicit_cast_impl<std::int8_t>(operand, result))
+	auto val = any_cast<To>(&operand);
+	if(val)
 	{
-		return true;
+		return detail::copy_exact(*val, result);
 	}
-	else if(implicit_cast_impl<std::int16_t>(operand, result))
-	{
-		return true;
-	}
-	else if(implicit_cast_impl<std::int32_t>(operand, result))
+
+	// otherwise a single lookup finds the conversion from the stored type
+	const auto& table = detail::conversion_table<To, Any>();
+	const auto it = table.find(std::type_index(operand.type()));
+	if(it == std::end(table))
 	{
-		return true;
+		return false;
 	}
-	else if(implicit_cast_impl<std::int64_t>(operand, result))
+	return it->second.from_any(operand, result);
+}
+
+//-----------------------------------------------------------------------------
+/// Remembers the conversion used for the last value cast through it, so that
+/// values of the same stored type skip the lookup. The slots keep one per
+/// argument. Safe to share between threads, the entries it points to are
+/// never modified.
+//-----------------------------------------------------------------------------
+template <typename To, typename Any = hpp::any>
+class conversion_cache
+{
+public:
+	using entry_t = typename detail::conversion_table_t<To, Any>::value_type;
+
+	conversion_cache() = default;
+	conversion_cache(const conversion_cache& rhs) noexcept
+		: entry_(rhs.get())
 	{
-		return true;
 	}
-	else if(implicit_cast_impl<std::uint8_t>(operand, result))
+	conversion_cache& operator=(const conversion_cache& rhs) noexcept
 	{
-		return true;
+		set(rhs.get());
+		return *this;
 	}
-	else if(implicit_cast_impl<std::uint16_t>(operand, result))
+
+	const entry_t* get() const noexcept
 	{
-		return true;
+		return entry_.load(std::memory_order_acquire);
 	}
-	else if(implicit_cast_impl<std::uint32_t>(operand, result))
+
+	void set(const entry_t* entry) noexcept
 	{
-		return true;
+		entry_.store(entry, std::memory_order_release);
 	}
-	else if(implicit_cast_impl<std::uint64_t>(operand, result))
+
+private:
+	std::atomic<const entry_t*> entry_{nullptr};
+};
+
+// Same as above, trying the conversion which worked last time first
+template <typename To, typename Any>
+bool try_implicit_cast(const Any& operand, To& result, conversion_cache<To, Any>& cache)
+{
+	const auto cached = cache.get();
+	if(cached != nullptr && cached->first == std::type_index(operand.type()))
 	{
-		return true;
+		return cached->second.from_any(operand, result);
 	}
-	else if(implicit_cast_impl<float>(operand, result))
+
+	auto val = any_cast<To>(&operand);
+	if(val)
 	{
-		return true;
+		if(cached != nullptr)
+		{
+			cache.set(nullptr);
+		}
+		return detail::copy_exact(*val, result);
 	}
-	else if(implicit_cast_impl<double>(operand, result))
+
+	const auto& table = detail::conversion_table<To, Any>();
+	const auto it = table.find(std::type_index(operand.type()));
+	if(it == std::end(table))
 	{
-		return true;
+		return false;
 	}
-	else if(implicit_cast_impl<char>(operand, result))
+	cache.set(std::addressof(*it));
+	return it->second.from_any(operand, result);
+}
+
+//-----------------------------------------------------------------------------
+/// Argument packed by address instead of by value, which is only valid while
+/// the caller is blocked in a synchronous dispatch or call.
+//-----------------------------------------------------------------------------
+struct borrowed_arg
+{
+	const void* value;
+	const std::type_info* type;
+	/// borrowed from a non-const rvalue, which the last reader may move from
+	bool movable;
+};
+
+// Same as above, for borrowed arguments
+template <typename To, typename Any>
+bool try_implicit_cast(const borrowed_arg& operand, To& result, conversion_cache<To, Any>& cache)
+{
+	const auto cached = cache.get();
+	if(cached != nullptr && cached->first == std::type_index(*operand.type))
 	{
+		cached->second.from_value(operand.value, result);
 		return true;
 	}
-	else if(implicit_cast_impl<unsigned char>(operand, result))
+
+	if(*operand.type == typeid(To))
 	{
-		return true;
+		if(cached != nullptr)
+		{
+			cache.set(nullptr);
+		}
+		return detail::copy_exact(*static_cast<const To*>(operand.value), result);
 	}
-	else if(implicit_cast_impl<std::nullptr_t>(operand, result))
+
+	const auto& table = detail::conversion_table<To, Any>();
+	const auto it = table.find(std::type_index(*operand.type));
+	if(it == std::end(table))
 	{
-		return true;
+		return false;
 	}
-
-	return false;
+	cache.set(std::addressof(*it));
+	it->second.from_value(operand.value, result);
+	return true;
 }
 
-struct anystream
+//-----------------------------------------------------------------------------
+/// Archive storing the values in anys. Up to InlineArgs of them are kept in
+/// the stream itself, more go to the heap. Any can be hpp::any or a
+/// dyno::basic_any, whose capacity decides which values need a heap holder.
+//-----------------------------------------------------------------------------
+template <std::size_t InlineArgs = 4, typename Any = hpp::any>
+struct basic_anystream
 {
-	using storage_t = std::vector<hpp::any>;
-	anystream() = default;
-	anystream(const anystream& rhs)
+	using any_t = Any;
+	using storage_t = small_vector<Any, InlineArgs>;
+	using borrowed_storage_t = small_vector<borrowed_arg, InlineArgs>;
+	basic_anystream() = default;
+	basic_anystream(const basic_anystream& rhs)
 		: internal_storage(*rhs.work_storage)
 		, work_storage(std::addressof(internal_storage))
+		, borrowed_storage(rhs.borrowed_storage)
 	{
 	}
-	anystream(anystream&& rhs) noexcept
+	basic_anystream(basic_anystream&& rhs) noexcept
 		: internal_storage(std::move(rhs.internal_storage))
 		, work_storage(std::addressof(internal_storage))
+		, borrowed_storage(std::move(rhs.borrowed_storage))
 	{
 	}
 
-	anystream& operator=(const anystream& rhs)
+	basic_anystream& operator=(const basic_anystream& rhs)
 	{
 		internal_storage = (*rhs.work_storage);
 		work_storage = std::addressof(internal_storage);
+		borrowed_storage = rhs.borrowed_storage;
 
 		return *this;
 	}
-	anystream& operator=(anystream&& rhs) noexcept
+	basic_anystream& operator=(basic_anystream&& rhs) noexcept
 	{
 		internal_storage = std::move(rhs.internal_storage);
 		work_storage = std::addressof(internal_storage);
+		borrowed_storage = std::move(rhs.borrowed_storage);
 
 		return *this;
 	}
 	// create from external storage
-	anystream(const storage_t& s)
+	basic_anystream(const storage_t& s)
 		: work_storage(&s)
 	{
 	}
+	// create owning the storage, so that its values can be moved out
+	basic_anystream(storage_t&& s)
+		: internal_storage(std::move(s))
+	{
+	}
 
 	template <typename T>
-	anystream& operator<<(T&& val) noexcept
+	basic_anystream& operator<<(T&& val) noexcept
 	{
+		static_assert(std::is_copy_constructible<std::decay_t<T>>::value || detail::holds_move_only<Any>::value,
+					  "move-only values need an anystream over dyno::basic_any");
 		const_cast<storage_t*>(work_storage)->emplace_back(std::forward<T>(val));
 		return *this;
 	}
 
+	// packs the address of the value, see borrowed_arg
 	template <typename T>
-	anystream& operator>>(T& val) noexcept
+	basic_anystream& borrow(T&& val) noexcept
 	{
-		if(!is_ok)
+		constexpr bool movable = !std::is_lvalue_reference<T>::value && !std::is_const<T>::value;
+		borrowed_storage.emplace_back(borrowed_arg{std::addressof(val), &typeid(std::decay_t<T>), movable});
+		return *this;
+	}
+
+	template <typename T>
+	basic_anystream& operator>>(T& val) noexcept
+	{
+		conversion_cache<T, Any> cache;
+		return read(val, cache);
+	}
+
+	template <typename T>
+	basic_anystream& read(T& val, conversion_cache<T, Any>& cache) noexcept
+	{
+		if(is_borrowed())
 		{
+			const auto arg = next_borrowed();
+			is_ok = arg != nullptr && try_implicit_cast(*arg, val, cache);
 			return *this;
 		}
-		if(idx < work_storage->size())
+		const auto any_obj = next();
+		is_ok = any_obj != nullptr && try_implicit_cast(*any_obj, val, cache);
+		return *this;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Points ref to the next value if it is exactly a T, borrowed or stored,
+	/// which then stays valid as long as the stream and its storage do.
+	/// Otherwise returns false and the value is left to read.
+	//-----------------------------------------------------------------------------
+	template <typename T>
+	bool read_ref(const T*& ref) noexcept
+	{
+		if(!is_ok)
 		{
-			const auto& any_obj = (*work_storage)[idx++];
-			is_ok &= try_implicit_cast(any_obj, val);
+			return false;
 		}
-		else
+		if(is_borrowed())
 		{
-			is_ok = false;
+			if(idx >= borrowed_storage.size() || *borrowed_storage[idx].type != typeid(T))
+			{
+				return false;
+			}
+			ref = static_cast<const T*>(borrowed_storage[idx].value);
+			++idx;
+			return true;
 		}
+		if(idx >= work_storage->size())
+		{
+			return false;
+		}
+		const auto value = any_cast<T>(std::addressof((*work_storage)[idx]));
+		if(value == nullptr)
+		{
+			return false;
+		}
+		ref = value;
+		++idx;
+		return true;
+	}
 
-		return *this;
+	//-----------------------------------------------------------------------------
+	/// Points ptr to the next value if it is exactly a T which can be moved
+	/// from: one of its own values, or an argument borrowed from an rvalue.
+	/// Values in external storage belong to someone else and never qualify.
+	//-----------------------------------------------------------------------------
+	template <typename T>
+	bool read_movable(T*& ptr) noexcept
+	{
+		if(!is_ok)
+		{
+			return false;
+		}
+		if(is_borrowed())
+		{
+			if(idx >= borrowed_storage.size() || !borrowed_storage[idx].movable ||
+			   *borrowed_storage[idx].type != typeid(T))
+			{
+				return false;
+			}
+			// only ever set for non-const objects
+			ptr = static_cast<T*>(const_cast<void*>(borrowed_storage[idx].value));
+			++idx;
+			return true;
+		}
+		if(has_external_storage() || idx >= internal_storage.size())
+		{
+			return false;
+		}
+		const auto value = any_cast<T>(std::addressof(internal_storage[idx]));
+		if(value == nullptr)
+		{
+			return false;
+		}
+		ptr = value;
+		++idx;
+		return true;
 	}
 
 	void rewind() noexcept
@@ -175,9 +417,37 @@ struct anystream
 		return work_storage != std::addressof(internal_storage);
 	}
 
+	bool is_borrowed() const noexcept
+	{
+		return !borrowed_storage.empty();
+	}
+
+	// the next value to read, if any and if nothing failed so far
+	const Any* next() noexcept
+	{
+		if(!is_ok || idx >= work_storage->size())
+		{
+			return nullptr;
+		}
+		return std::addressof((*work_storage)[idx++]);
+	}
+
+	const borrowed_arg* next_borrowed() noexcept
+	{
+		if(!is_ok || idx >= borrowed_storage.size())
+		{
+			return nullptr;
+		}
+		return std::addressof(borrowed_storage[idx++]);
+	}
+
 	std::size_t idx = 0;
 	bool is_ok = true;
 	storage_t internal_storage;
 	const storage_t* work_storage{std::addressof(internal_storage)};
+	/// arguments packed by address, in which case internal_storage stays empty
+	borrowed_storage_t borrowed_storage;
 };
+
+using anystream = basic_anystream<>;
 }
@@ -2,28 +2,109 @@
 #define DYNO_BINDER_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <future>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+#include "any.hpp"
 #include "archive.h"
+#include "binder_traits.hpp"
+#include "containers/topic_trie.hpp"
 #include <hpp/optional.hpp>
+#include <hpp/string_view.hpp>
 #include <hpp/type_traits.hpp>
 #include <hpp/utility.hpp>
 
 namespace dyno
 {
 
+template <typename Binder>
+class event_inbox;
+
+namespace detail
+{
+// Ids looked up as they are, without constructing a View: C strings and
+// string views, when the keys are strings.
+template <typename Key, typename View, typename T>
+using is_lookup_view =
+	std::integral_constant<bool, is_string_like<Key>::value &&
+									 std::is_constructible<Key, hpp::string_view>::value &&
+									 !std::is_same<T, View>::value &&
+									 (std::is_convertible<const T&, const char*>::value ||
+									  std::is_same<T, hpp::string_view>::value)>;
+
+inline hpp::string_view lookup_view(hpp::string_view id)
+{
+	return id;
+}
+
+//-----------------------------------------------------------------------------
+/// Per argument unpack caches of a slot, remembering how the previous call was
+/// unpacked. Kept next to the slot's delegate and passed to it, rather than
+/// captured, so that member function slots and small lambdas stay inplace.
+//-----------------------------------------------------------------------------
+using slot_caches = basic_any<>;
+
+template <typename Caches, bool = std::is_empty<Caches>::value>
+struct slot_caches_of
+{
+	static slot_caches make()
+	{
+		return Caches{};
+	}
+
+	static Caches& get(slot_caches& caches) noexcept
+	{
+		auto result = caches.template get<Caches>();
+		assert(result && "slot caches of another slot");
+		return *result;
+	}
+};
+
+// archives without caches store nothing
+template <typename Caches>
+struct slot_caches_of<Caches, true>
+{
+	static slot_caches make() noexcept
+	{
+		return {};
+	}
+
+	static Caches& get(slot_caches&) noexcept
+	{
+		static Caches caches;
+		return caches;
+	}
+};
+}
+
+//-----------------------------------------------------------------------------
+/// Order in which dispatch_many runs the slots over the events.
+/// - event_major: every event goes through all slots before the next one,
+///   same as calling dispatch in a loop.
+/// - slot_major: every slot receives all events before the next slot runs.
+///   Better cache locality, but slots observe the other slots out of order.
+//-----------------------------------------------------------------------------
+enum class dispatch_order
+{
+	event_major,
+	slot_major
+};
+
 template <typename OArchive, typename IArchive, typename Key = std::string, typename View = Key,
-		  typename Sentinel = std::weak_ptr<void>>
+		  typename Sentinel = std::weak_ptr<void>, typename Traits = binder_traits>
 struct binder
 {
 
@@ -34,11 +115,57 @@ public:
 	using key_t = Key;
 	using view_t = View;
 	using sentinel_t = Sentinel;
+	using traits_t = Traits;
 
 	static_assert(std::is_constructible<Key, View>::value, "key type must be constructable from view type");
 
+private:
+	struct slots;
+	struct unicast_info;
+
+public:
+	//-----------------------------------------------------------------------------
+	/// Pre-resolved multicast signal. Stays valid for the lifetime of the binder
+	/// regardless of any connects/disconnects on the signal.
+	//-----------------------------------------------------------------------------
+	struct signal_handle
+	{
+		explicit operator bool() const noexcept
+		{
+			return !!slots_;
+		}
+
+	private:
+		friend struct binder;
+		std::shared_ptr<slots> slots_;
+	};
+
+	//-----------------------------------------------------------------------------
+	/// Pre-resolved unicast slot. Stays valid for the lifetime of the binder
+	/// regardless of any binds/unbinds on the slot.
+	//-----------------------------------------------------------------------------
+	struct call_handle
+	{
+		explicit operator bool() const noexcept
+		{
+			return !!info_;
+		}
+
+	private:
+		friend struct binder;
+		std::shared_ptr<unicast_info> info_;
+	};
+
 	//-----------------------------------------------------------------------------
 	/// Connects a multicast slot to a given signal and returns an id to it.
+	/// For string keys the id can be a pattern made of '.' separated segments,
+	/// where '*' matches exactly one segment and a trailing '**' one or more.
+	/// "net.peer.*" receives "net.peer.joined", "net.**" every signal under "net".
+	/// Pattern slots run after the slots of the dispatched key, from the most
+	/// specific pattern to the least. The patterns matching a key are cached on
+	/// its entry, so dispatching keeps costing a single lookup. Entries kept only
+	/// for that are dropped when a pattern goes away, or when more than
+	/// Traits::wildcard_cache_size of them pile up.
 	//-----------------------------------------------------------------------------
 	template <typename F>
 	slot_t connect(const View& id, F&& f, std::uint32_t priority = 0);
@@ -57,9 +184,71 @@ public:
 
 	//-----------------------------------------------------------------------------
 	/// Dispatch a signal with the given args.
+	/// Reaches the wildcard patterns matching the key as well. The args are then
+	/// passed to all of them as const references instead of being forwarded.
+	/// With string keys, C strings and string views are looked up as they are,
+	/// so dispatching a literal never builds a temporary View. Same for call
+	/// and is_bound.
 	//-----------------------------------------------------------------------------
 	template <typename... Args>
 	void dispatch(const View& id, Args&&... args);
+	template <typename T, typename... Args,
+			  typename std::enable_if_t<detail::is_lookup_view<Key, View, T>::value>* = nullptr>
+	void dispatch(const T& id, Args&&... args);
+	template <typename... Args>
+	void dispatch(const signal_handle& handle, Args&&... args);
+
+	//-----------------------------------------------------------------------------
+	/// Dispatches a signal once per tuple of args in the range.
+	/// The lookup, the flush of pending slots and the sentinel validation are
+	/// done once for the whole range. Slots paused or expired at the start are
+	/// skipped for all events, while slots disconnected midway stop receiving.
+	/// The wildcard patterns matching the key receive the whole range after the
+	/// exact key's slots.
+	//-----------------------------------------------------------------------------
+	template <typename Range>
+	void dispatch_many(const View& id, const Range& events,
+					   dispatch_order order = dispatch_order::event_major);
+	template <typename Range>
+	void dispatch_many(const signal_handle& handle, const Range& events,
+					   dispatch_order order = dispatch_order::event_major);
+
+	//-----------------------------------------------------------------------------
+	/// Dispatches a signal running its slots in parallel on a pool providing
+	/// parallel_for(count, f), like dyno::thread_pool. Returns after all slots ran.
+	/// Slots of the same priority run concurrently, a priority band starts only
+	/// after the higher one finished. The args are packed once and shared, so
+	/// slots must be safe to run concurrently and must not use the binder.
+	/// The slots of the wildcard patterns matching the key run after the exact
+	/// key's slots, pattern by pattern.
+	//-----------------------------------------------------------------------------
+	template <typename Pool, typename... Args>
+	void dispatch_parallel(Pool& pool, const View& id, Args&&... args);
+
+	//-----------------------------------------------------------------------------
+	/// Queues a signal with the given args, to be dispatched by process_queue.
+	/// Only the packing of the args is paid upfront.
+	//-----------------------------------------------------------------------------
+	template <typename... Args>
+	void enqueue(const View& id, Args&&... args);
+
+	//-----------------------------------------------------------------------------
+	/// Dispatches the queued signals and returns how many were processed.
+	/// Ordering guarantees:
+	/// - events of the same signal are dispatched in the order they were queued.
+	/// - all queued events of a signal are dispatched as one batch, with a single
+	///   lookup and flush of the pending slots. So slots connected during a batch
+	///   only receive the events of the following batches.
+	/// - batches run in the order their signals were first queued, which means
+	///   events of different signals are not kept in their relative order.
+	/// - events queued while processing wait for the next process_queue call.
+	//-----------------------------------------------------------------------------
+	std::size_t process_queue();
+
+	//-----------------------------------------------------------------------------
+	/// Resolves a signal to a handle which can be dispatched without a key lookup.
+	//-----------------------------------------------------------------------------
+	signal_handle resolve(const View& id);
 
 	//-----------------------------------------------------------------------------
 	/// Binds an unicast slot.
@@ -77,6 +266,8 @@ public:
 	/// Check if a unicast is bound.
 	//-----------------------------------------------------------------------------
 	bool is_bound(const View& id) const;
+	template <typename T, typename std::enable_if_t<detail::is_lookup_view<Key, View, T>::value>* = nullptr>
+	bool is_bound(const T& id) const;
 
 	//-----------------------------------------------------------------------------
 	/// Unbinds an unicast slot.
@@ -88,6 +279,28 @@ public:
 	//-----------------------------------------------------------------------------
 	template <typename R = void, typename... Args>
 	decltype(auto) call(const View& id, Args&&... args);
+	template <typename R = void, typename T, typename... Args,
+			  typename std::enable_if_t<detail::is_lookup_view<Key, View, T>::value>* = nullptr>
+	decltype(auto) call(const T& id, Args&&... args);
+	template <typename R = void, typename... Args>
+	decltype(auto) call(const call_handle& handle, Args&&... args);
+
+	//-----------------------------------------------------------------------------
+	/// Resolves an unicast slot to a handle which can be called without a key lookup.
+	//-----------------------------------------------------------------------------
+	call_handle resolve_call(const View& id);
+
+	//-----------------------------------------------------------------------------
+	/// Calls an unicast slot on an executor and returns a future to its result.
+	/// The executor is anything with submit(task) or operator()(task), like
+	/// dyno::thread_pool. The args are packed on the calling thread and the
+	/// sentinel is locked on the executing thread for the duration of the call.
+	/// Unbinding meanwhile does not affect the calls already submitted.
+	//-----------------------------------------------------------------------------
+	template <typename R = void, typename Executor, typename... Args>
+	std::future<R> call_async(Executor& executor, const View& id, Args&&... args);
+	template <typename R = void, typename Executor, typename... Args>
+	std::future<R> call_async(Executor& executor, const call_handle& handle, Args&&... args);
 
 	//-----------------------------------------------------------------------------
 	/// Clears out the binder.
@@ -100,28 +313,89 @@ public:
 	void flush_pending();
 
 private:
+	template <typename K, typename... Args>
+	void dispatch_key(const K& id, Args&&... args);
+
+	template <typename R, typename K, typename... Args>
+	decltype(auto) call_key(const K& id, Args&&... args);
+
+	template <typename K>
+	bool is_bound_key(const K& id) const;
+
 	template <typename... Args>
-	void dispatch_impl(const View& id, Args&&... args);
+	bool dispatch_impl(slots& signal, Args&&... args);
+
+	template <typename Invoke>
+	bool dispatch_slots(slots& signal, Invoke&& invoke);
+
+	template <typename Range>
+	bool dispatch_many_impl(slots& signal, const Range& events, dispatch_order order);
+
+	template <typename Pool, typename... Args>
+	bool dispatch_parallel_impl(Pool& pool, slots& signal, Args&&... args);
+
+	void erase_if_empty(slots& signal);
+
+	// dispatch(slots&) runs on the signal and on the patterns matching its key
+	template <typename Dispatch>
+	void dispatch_matching(const std::shared_ptr<slots>& entry, Dispatch&& dispatch);
+
+	// dispatch(slots&) runs on the patterns matching the signal's key only
+	template <typename Dispatch>
+	void dispatch_wildcards(slots& signal, Dispatch&& dispatch);
+
+	template <typename K>
+	bool matches_wildcard(const K& id) const;
+	void refresh_wildcards(slots& signal);
+	bool remove_pattern(const slots& signal);
+	const std::shared_ptr<slots>& add_signal(Key id);
+	const std::shared_ptr<slots>& add_cached_signal(Key id);
+	void sweep_cached_signals();
+
+	template <typename Binder>
+	friend class event_inbox;
+
+	// dispatches args already packed by enqueue or by an event_inbox
+	void dispatch_storage(const View& id, const typename archive_t::storage_t& args);
+	// process_queue flushes the pending slots once per batch instead
+	bool dispatch_storage_impl(slots& signal, const typename archive_t::storage_t& args, bool flush);
+
+	template <typename R, typename Executor, typename... Args>
+	std::future<R> call_async_impl(Executor& executor, unicast_info& info, Args&&... args);
 
 	template <typename R, typename... Args, typename std::enable_if_t<!std::is_void<R>::value>* = nullptr>
-	R call_impl(const View& id, Args&&... args);
+	R call_impl(unicast_info& info, Args&&... args);
 
 	template <typename R = void, typename... Args,
 			  typename std::enable_if_t<std::is_void<R>::value>* = nullptr>
-	R call_impl(const View& id, Args&&... args);
+	R call_impl(unicast_info& info, Args&&... args);
+
+	using locked_sentinel_t = decltype(std::declval<const Sentinel&>().lock());
+	locked_sentinel_t lock_unicast(unicast_info& info, const char* func, const char* expired_msg);
+
+	template <typename F>
+	slot_t connect_impl(const View& id, hpp::optional<Sentinel> sentinel, F&& f, std::uint32_t priority);
+
+	unicast_info& bind_impl(const View& id);
+
+	using unicast_t = typename Traits::template delegate_t<OArchive(IArchive&, detail::slot_caches&)>;
 
-	slot_t id_gen_{0};
-	inline slot_t generate_id()
+	struct unicast_slot
 	{
-		return ++id_gen_;
-	}
+		/// The function wrapper
+		unicast_t invoke;
+		/// Unpack caches of its arguments, shared with the pending async calls as well
+		mutable detail::slot_caches caches;
+	};
 
 	struct unicast_info
 	{
+		/// The key it was bound with, used for diagnostics
+		Key id;
 		/// Sentinel used for life tracking
 		hpp::optional<Sentinel> sentinel;
-		/// The function wrapper
-		delegate_t<OArchive(IArchive&)> unicast;
+		/// The function wrapper, shared with the pending async calls
+		std::shared_ptr<const unicast_slot> unicast;
 	};
 
 	struct multicast_info
@@ -131,24 +405,100 @@ private:
 		std::uint32_t priority{0};
 		/// Sentinel used for life tracking
 		hpp::optional<Sentinel> sentinel;
+		/// Decayed argument types of the slot, used for the typed fast path
+		const void* signature{nullptr};
 		/// The function wrapper
-		delegate_t<void(IArchive&)> multicast;
+		typename Traits::template delegate_t<void(IArchive*, const void*, bool, detail::slot_caches&)> multicast;
+		/// Unpack caches of its arguments
+		mutable detail::slot_caches caches;
 	};
 	struct slots
 	{
+		/// The key it was connected with, used for diagnostics
+		Key id;
 		std::vector<multicast_info> active;
 		std::vector<multicast_info> pending;
+		/// Connected slots, including expired ones not collected yet
+		std::size_t live{0};
+		/// Disconnected slots still taking space in the active container
+		std::size_t garbage{0};
 		uint32_t depth{0};
 		bool collect_garbage{false};
+		/// Wildcard patterns matching the key, valid while wildcard_version is current
+		std::vector<std::weak_ptr<slots>> wildcards;
+		std::uint64_t wildcard_version{0};
 	};
 	void flush_pending(std::vector<multicast_info>& container,
 					   std::vector<multicast_info>& container_pending);
 
+	struct slot_entry
+	{
+		/// Incremented on every release, invalidating the old slot ids
+		std::uint32_t generation{1};
+		/// Index into the container the slot currently lives in
+		std::uint32_t position{0};
+		/// Whether that container is the pending one
+		bool pending{false};
+		/// The signal the slot is connected to, null when free
+		slots* signal{nullptr};
+	};
+
+	// A slot id is the slot's index into slot_table_ in the low half and its
+	// generation in the high half, so stale ids never match a reused entry.
+	static std::uint32_t slot_index(slot_t slot_id)
+	{
+		return std::uint32_t(slot_id & 0xffffffff);
+	}
+	static std::uint32_t slot_generation(slot_t slot_id)
+	{
+		return std::uint32_t(slot_id >> 32);
+	}
+
+	slot_t acquire_slot(slots& signal);
+	slot_entry* find_slot(slot_t slot_id);
+	void release_slot(slot_t slot_id);
+	void release_slots(slots& signal);
+	void compact(slots& signal);
+
+	/// Entries referenced by a handle are never erased, only emptied.
+	template <typename T>
+	static bool is_resolved(const std::shared_ptr<T>& entry)
+	{
+		return entry.use_count() > 1;
+	}
+
 	/// container with the multicast slots
-	std::map<Key, slots, std::less<>> multicast_list_;
+	typename Traits::template table_t<Key, std::shared_ptr<slots>> multicast_list_;
 
 	/// container with the unicast slots
-	std::map<Key, unicast_info, std::less<>> unicast_list_;
+	typename Traits::template table_t<Key, std::shared_ptr<unicast_info>> unicast_list_;
+
+	/// wildcard patterns, pointing to their entries in multicast_list_
+	topic_trie<std::weak_ptr<slots>> wildcard_trie_;
+
+	/// bumped whenever a pattern is added or removed, invalidating the cached matches
+	std::uint64_t wildcard_version_{1};
+
+	/// entries added by dispatches only to cache their matching patterns, since the last sweep
+	std::size_t cached_signals_{0};
+
+	struct queued_event
+	{
+		constexpr static std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+		Key id;
+		typename archive_t::storage_t args;
+		/// next event of the same signal, set by process_queue
+		std::size_t next{npos};
+		bool processed{false};
+	};
+
+	/// events waiting for process_queue
+	std::vector<queued_event> queue_;
+
+	/// slot map for the ids handed out by connect
+	std::vector<slot_entry> slot_table_;
+	std::vector<std::uint32_t> free_slots_;
 };
 
 namespace detail
@@ -166,53 +516,228 @@ inline std::string diagnostic(const char* func, const T& val)
 	return os.str();
 }
 
+// What calling an unbound key reports, a call expecting a result says so.
+template <typename R>
+constexpr const char* unbound_message()
+{
+	return std::is_void<R>::value ? "invoking a non-binded function"
+								  : "invoking a non-binded function and expecting a return value";
+}
+
+// Counts a dispatch in progress on a signal. The depth is restored however
+// the dispatch ends, a throwing slot must not keep the signal from compacting.
+class dispatch_depth
+{
+public:
+	explicit dispatch_depth(std::uint32_t& depth) noexcept
+		: depth_(depth)
+	{
+		++depth_;
+	}
+	~dispatch_depth()
+	{
+		--depth_;
+	}
+	dispatch_depth(const dispatch_depth&) = delete;
+	dispatch_depth& operator=(const dispatch_depth&) = delete;
+
+private:
+	std::uint32_t& depth_;
+};
+
+// Hands the archives created by a dispatch back to the archive once it is
+// over, including when a slot throws.
+template <typename Archive, typename IArchives>
+class recycle_scope
+{
+public:
+	explicit recycle_scope(IArchives& iarchives) noexcept
+		: iarchives_(iarchives)
+	{
+	}
+	~recycle_scope()
+	{
+		for(auto& iarchive : iarchives_)
+		{
+			if(iarchive)
+			{
+				recycle<Archive>(std::move(iarchive.value()));
+			}
+		}
+	}
+	recycle_scope(const recycle_scope&) = delete;
+	recycle_scope& operator=(const recycle_scope&) = delete;
+
+private:
+	IArchives& iarchives_;
+};
+
+// The topic of char string keys, as split into segments by the wildcard patterns.
+// Other keys have none, so they neither are nor match patterns.
+template <typename T>
+using topic_expression =
+	decltype(std::declval<const char*&>() = std::declval<const T&>().data(), std::declval<const T&>().size());
+template <typename T>
+using has_topic = hpp::is_detected<topic_expression, T>;
+
+template <typename T, typename std::enable_if<has_topic<T>::value, int>::type = 0>
+inline bool topic_of(const T& id, const char*& data, std::size_t& size)
+{
+	data = id.data();
+	size = id.size();
+	return true;
+}
+
+template <typename T, typename std::enable_if<!has_topic<T>::value, int>::type = 0>
+inline bool topic_of(const T&, const char*&, std::size_t&)
+{
+	return false;
+}
+
+// Member function bound to an object. Unlike a lambda it exposes the
+// exact parameter types and stays small enough to be stored inplace.
+template <typename C, typename M, typename Ret, typename... Ts>
+struct bound_member
+{
+	C* object;
+	M method;
+
+	Ret operator()(Ts... args) const
+	{
+		return (object->*method)(std::forward<Ts>(args)...);
+	}
+};
+
 template <class C, typename Ret, typename... Ts>
-delegate_t<Ret(Ts...)> bind_this(C* c, Ret (C::*m)(Ts...))
+bound_member<C, Ret (C::*)(Ts...), Ret, Ts...> bind_this(C* c, Ret (C::*m)(Ts...))
 {
-	return [=](auto&&... args) { return (c->*m)(std::forward<decltype(args)>(args)...); };
+	return {c, m};
 }
 
 template <class C, typename Ret, typename... Ts>
-delegate_t<Ret(Ts...)> bind_this(const C* c, Ret (C::*m)(Ts...) const)
+bound_member<const C, Ret (C::*)(Ts...) const, Ret, Ts...> bind_this(const C* c, Ret (C::*m)(Ts...) const)
 {
-	return [=](auto&&... args) { return (c->*m)(std::forward<decltype(args)>(args)...); };
+	return {c, m};
 }
 
 template <class C, typename Ret, typename... Ts>
-delegate_t<Ret(Ts...)> bind_this(C* const c, Ret (C::*m)(Ts...) const)
+bound_member<C, Ret (C::*)(Ts...) const, Ret, Ts...> bind_this(C* const c, Ret (C::*m)(Ts...) const)
+{
+	return {c, m};
+}
+
+template <bool... Bs>
+using all_of =
+	std::is_same<std::integer_sequence<bool, true, Bs...>, std::integer_sequence<bool, Bs..., true>>;
+
+template <typename T>
+struct type_tag
 {
-	return [=](auto&&... args) { return (c->*m)(std::forward<decltype(args)>(args)...); };
+	static const char id;
+};
+template <typename T>
+const char type_tag<T>::id{};
+
+// Arrays and functions decay to a temporary, so they cannot be referenced directly.
+template <typename T, typename U = std::remove_reference_t<T>>
+using is_directly_referable =
+	std::integral_constant<bool, !std::is_array<U>::value && !std::is_function<U>::value>;
+
+template <typename T>
+using typed_arg_t =
+	std::conditional_t<is_directly_referable<T>::value, const std::decay_t<T>&, std::decay_t<T>>;
+
+// References to the caller's arguments as seen by the typed fast path.
+template <typename... Args>
+using typed_args_t = std::tuple<typed_arg_t<Args>...>;
+
+//-----------------------------------------------------------------------------
+/// Unique id of a decayed argument list. Slots and dispatches with the same id
+/// exchange arguments directly without going through an archive.
+//-----------------------------------------------------------------------------
+template <typename... Args>
+inline const void* signature_of_args()
+{
+	if(!all_of<is_directly_referable<Args>::value...>::value)
+	{
+		return nullptr;
+	}
+	return &type_tag<std::tuple<std::decay_t<Args>...>>::id;
 }
 
-template <typename OArchive, typename IArchive, typename F, typename Tuple>
-std::enable_if_t<std::is_void<hpp::fn_result_of<F>>::value> apply_impl(OArchive&, F&& f, Tuple&& args)
+// Signature and typed args of the events of a dispatch_many range.
+template <typename Tuple>
+struct typed_event;
+
+template <typename... Ts>
+struct typed_event<std::tuple<Ts...>>
+{
+	using args_t = typed_args_t<const Ts&...>;
+
+	static const void* signature()
+	{
+		return signature_of_args<const Ts&...>();
+	}
+};
+
+template <typename Tuple>
+struct typed_invoker;
+
+template <typename... Ts>
+struct typed_invoker<std::tuple<Ts...>>
+{
+	// Slots taking a non-const lvalue reference get their own copy as they would from an archive.
+	template <typename P>
+	using param_t = std::conditional_t<std::is_lvalue_reference<P>::value &&
+										   !std::is_const<std::remove_reference_t<P>>::value,
+									   std::decay_t<P>, const std::decay_t<P>&>;
+
+	static const void* signature()
+	{
+		return signature_of_args<Ts...>();
+	}
+
+	template <typename F>
+	static void invoke(const F& f, const void* typed_args)
+	{
+		using params_t = std::tuple<param_t<Ts>...>;
+		params_t params(*static_cast<const typed_args_t<std::decay_t<Ts>...>*>(typed_args));
+		hpp::apply(f, params);
+	}
+};
+
+template <typename F>
+using fn_invoker = typed_invoker<typename hpp::function_traits<F>::arg_types>;
+
+template <typename OArchive, typename IArchive, typename F, typename Args>
+std::enable_if_t<std::is_void<hpp::fn_result_of<F>>::value> apply_impl(OArchive&, F& f, Args& args)
 {
-	hpp::apply(f, args);
+	invoke_unpacked(f, args);
 }
 
-template <typename OArchive, typename IArchive, typename F, typename Tuple>
-std::enable_if_t<!std::is_void<hpp::fn_result_of<F>>::value> apply_impl(OArchive& oarchive, F&& f,
-																		Tuple&& args)
+template <typename OArchive, typename IArchive, typename F, typename Args>
+std::enable_if_t<!std::is_void<hpp::fn_result_of<F>>::value> apply_impl(OArchive& oarchive, F& f, Args& args)
 {
 	using archive_t = archive<OArchive, IArchive>;
-	archive_t::pack(oarchive, hpp::apply(f, args));
+	archive_t::pack(oarchive, invoke_unpacked(f, args));
 }
 
 template <typename OArchive, typename IArchive, typename F>
-inline delegate_t<OArchive(IArchive&)> package_unicast(F&& f)
+inline auto package_unicast(F&& f, slot_caches& caches)
 {
 	using archive_t = archive<OArchive, IArchive>;
 	using tuple_args = typename hpp::function_traits<F>::arg_types_decayed;
-
-	return [f = std::forward<F>(f)](IArchive & iarchive)
-	{
-		tuple_args args;
-		hpp::for_each(args, [&iarchive](auto& element) {
-			if(!archive_t::unpack(iarchive, element))
-			{
-				throw std::runtime_error("cannot not unpack the expected arguments");
-			}
-		});
+	using unpacked_args = detail::unpacked_args_t<archive_t, typename hpp::function_traits<F>::arg_types>;
+	using caches_t = slot_caches_of<detail::unpack_caches_t<archive_t, tuple_args>>;
+
+	caches = caches_t::make();
+	return [f = std::forward<F>(f)](IArchive& iarchive, slot_caches& caches) {
+		// a unicast is the only reader of its archive
+		unpacked_args args;
+		if(!detail::unpack_args<archive_t>(iarchive, args, caches_t::get(caches), true))
+		{
+			throw std::runtime_error("cannot not unpack the expected arguments");
+		}
 
 		auto oarchive = archive_t::create_oarchive();
 		apply_impl<OArchive, IArchive>(oarchive, f, args);
@@ -221,458 +746,1669 @@ inline delegate_t<OArchive(IArchive&)> package_unicast(F&& f)
 }
 
 template <typename OArchive, typename IArchive, typename C, typename F>
-inline delegate_t<OArchive(IArchive&)> package_unicast(C* const object_ptr, F&& f)
+inline auto package_unicast(C* const object_ptr, F&& f, slot_caches& caches)
 {
-	return package_unicast<OArchive, IArchive>(bind_this(object_ptr, std::forward<F>(f)));
+	return package_unicast<OArchive, IArchive>(bind_this(object_ptr, std::forward<F>(f)), caches);
 }
 
 template <typename OArchive, typename IArchive, typename F>
-inline delegate_t<void(IArchive&)> package_multicast(F&& f)
+inline auto package_multicast(F&& f, slot_caches& caches)
 {
 	using archive_t = archive<OArchive, IArchive>;
 	using tuple_args = typename hpp::function_traits<F>::arg_types_decayed;
+	using unpacked_args = detail::unpacked_args_t<archive_t, typename hpp::function_traits<F>::arg_types>;
+	using caches_t = slot_caches_of<detail::unpack_caches_t<archive_t, tuple_args>>;
+
+	// Invoked either with an archive or with the caller's own arguments
+	// when they match the slot signature exactly. 'last' when no other slot
+	// reads the archive afterwards.
+	caches = caches_t::make();
+	return [f = std::forward<F>(f)](IArchive* iarchive, const void* typed_args, bool last,
+									slot_caches& caches) {
+		if(typed_args)
+		{
+			fn_invoker<F>::invoke(f, typed_args);
+			return;
+		}
 
-	return [f = std::forward<F>(f)](IArchive & iarchive)
-	{
-		tuple_args args;
-		hpp::for_each(args, [&iarchive](auto& element) {
-			if(!archive_t::unpack(iarchive, element))
-			{
-				throw std::runtime_error("cannot not unpack the expected argument types");
-			}
-		});
+		unpacked_args args;
+		if(!detail::unpack_args<archive_t>(*iarchive, args, caches_t::get(caches), last))
+		{
+			throw std::runtime_error("cannot not unpack the expected argument types");
+		}
 
-		hpp::apply(f, args);
+		invoke_unpacked(f, args);
 	};
 }
 
 template <typename OArchive, typename IArchive, typename C, typename F>
-inline delegate_t<void(IArchive&)> package_multicast(C* const object_ptr, F&& f)
+inline auto package_multicast(C* const object_ptr, F&& f, slot_caches& caches)
 {
-	return package_multicast<OArchive, IArchive>(bind_this(object_ptr, std::forward<F>(f)));
-}
+	return package_multicast<OArchive, IArchive>(bind_this(object_ptr, std::forward<F>(f)), caches);
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
-template <typename F>
-slot_t binder<OArchive, IArchive, Key, View, Sentinel>::connect(const View& id, F&& f, std::uint32_t priority)
-{
-	static_assert(std::is_void<hpp::fn_result_of<F>>::value,
-				  "signals cannot have a return type different from void");
+// detecting executors with a submit(task) member, otherwise they are invoked
+template <typename E, typename F>
+using submit_expression = decltype(std::declval<E&>().submit(std::declval<F>()));
 
-	auto emp = multicast_list_.emplace(Key(id), slots{});
-	auto& container = emp.first->second;
-	container.pending.emplace_back();
-	auto& info = container.pending.back();
-	info.priority = priority;
-	info.multicast = detail::package_multicast<OArchive, IArchive>(std::forward<F>(f));
-	info.id = generate_id();
+template <typename E, typename F,
+		  typename std::enable_if<hpp::is_detected<submit_expression, E, F>::value, int>::type = 0>
+void execute(E& executor, F&& task)
+{
+	executor.submit(std::forward<F>(task));
+}
 
-	return info.id;
+template <typename E, typename F,
+		  typename std::enable_if<!hpp::is_detected<submit_expression, E, F>::value, int>::type = 0>
+void execute(E& executor, F&& task)
+{
+	executor(std::forward<F>(task));
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
-template <typename C, typename F>
-slot_t binder<OArchive, IArchive, Key, View, Sentinel>::connect(const View& id, C* const object_ptr, F&& f,
-																std::uint32_t priority)
+//-----------------------------------------------------------------------------
+/// State of a call_async. Owns everything it needs, so that it can run on
+/// another thread regardless of what happens to the binder meanwhile.
+//-----------------------------------------------------------------------------
+template <typename OArchive, typename IArchive, typename Key, typename Sentinel, typename Unicast, typename R>
+struct async_call
 {
-	static_assert(std::is_void<hpp::fn_result_of<F>>::value,
-				  "signals cannot have a return type different from void");
+	using archive_t = archive<OArchive, IArchive>;
 
-	auto emp = multicast_list_.emplace(Key(id), slots{});
-	auto& container = emp.first->second;
-	container.pending.emplace_back();
-	auto& info = container.pending.back();
-	info.priority = priority;
-	info.multicast = detail::package_multicast<OArchive, IArchive>(object_ptr, std::forward<F>(f));
-	info.id = generate_id();
+	void run()
+	{
+		constexpr static const auto this_func = "call_async";
+		try
+		{
+			// Keep the sentinel locked until end of call
+			decltype(std::declval<const Sentinel&>().lock()) locked{};
+			if(sentinel)
+			{
+				locked = sentinel.value().lock();
+				if(!locked)
+				{
+					throw std::runtime_error("invoking a non-binded function");
+				}
+			}
 
-	return info.id;
+			// runs once, so the arguments can be moved into the unicast
+			auto iarchive = archive_t::create_iarchive(std::move(args));
+			set_result(promise, unicast->invoke(iarchive, unicast->caches));
+		}
+		catch(const std::exception& e)
+		{
+			promise.set_exception(
+				std::make_exception_ptr(std::runtime_error(diagnostic(this_func, id) + e.what())));
+		}
+	}
+
+	static void set_result(std::promise<void>& result, OArchive&& oarchive)
+	{
+		detail::recycle<archive_t>(std::move(oarchive));
+		result.set_value();
+	}
+
+	template <typename T>
+	static void set_result(std::promise<T>& result, OArchive&& oarchive)
+	{
+		T res{};
+		auto result_iarchive = archive_t::create_iarchive(std::move(oarchive));
+		if(!detail::unpack_last<archive_t>(result_iarchive, res))
+		{
+			throw std::runtime_error("cannot unpack the expected return type");
+		}
+		detail::recycle<archive_t>(std::move(result_iarchive));
+		result.set_value(std::move(res));
+	}
+
+	Key id;
+	hpp::optional<Sentinel> sentinel;
+	std::shared_ptr<const Unicast> unicast;
+	typename archive_t::storage_t args;
+	std::promise<R> promise;
+};
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
 template <typename F>
-slot_t binder<OArchive, IArchive, Key, View, Sentinel>::connect(const View& id, const Sentinel& sentinel,
-																F&& f, std::uint32_t priority)
+slot_t binder<OArchive, IArchive, Key, View, Sentinel, Traits>::connect(const View& id, F&& f,
+																		std::uint32_t priority)
 {
 	static_assert(std::is_void<hpp::fn_result_of<F>>::value,
 				  "signals cannot have a return type different from void");
 
-	auto emp = multicast_list_.emplace(Key(id), slots{});
-	auto& container = emp.first->second;
-	container.pending.emplace_back();
-	auto& info = container.pending.back();
-	info.priority = priority;
-	info.sentinel = sentinel;
-	info.multicast = detail::package_multicast<OArchive, IArchive>(std::forward<F>(f));
-	info.id = generate_id();
-
-	return info.id;
+	return connect_impl(id, {}, std::forward<F>(f), priority);
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
 template <typename C, typename F>
-slot_t binder<OArchive, IArchive, Key, View, Sentinel>::connect(const View& id, const Sentinel& sentinel,
-																C* const object_ptr, F&& f,
-																std::uint32_t priority)
+slot_t binder<OArchive, IArchive, Key, View, Sentinel, Traits>::connect(const View& id, C* const object_ptr,
+																		F&& f, std::uint32_t priority)
 {
 	static_assert(std::is_void<hpp::fn_result_of<F>>::value,
 				  "signals cannot have a return type different from void");
 
-	auto emp = multicast_list_.emplace(Key(id), slots{});
-	auto& container = emp.first->second;
+	return connect_impl(id, {}, detail::bind_this(object_ptr, std::forward<F>(f)), priority);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename F>
+slot_t binder<OArchive, IArchive, Key, View, Sentinel, Traits>::connect(const View& id,
+																		const Sentinel& sentinel, F&& f,
+																		std::uint32_t priority)
+{
+	static_assert(std::is_void<hpp::fn_result_of<F>>::value,
+				  "signals cannot have a return type different from void");
+
+	return connect_impl(id, sentinel, std::forward<F>(f), priority);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename C, typename F>
+slot_t binder<OArchive, IArchive, Key, View, Sentinel, Traits>::connect(const View& id,
+																		const Sentinel& sentinel,
+																		C* const object_ptr, F&& f,
+																		std::uint32_t priority)
+{
+	static_assert(std::is_void<hpp::fn_result_of<F>>::value,
+				  "signals cannot have a return type different from void");
+
+	return connect_impl(id, sentinel, detail::bind_this(object_ptr, std::forward<F>(f)), priority);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename F>
+slot_t binder<OArchive, IArchive, Key, View, Sentinel, Traits>::connect_impl(const View& id,
+																			 hpp::optional<Sentinel> sentinel,
+																			 F&& f, std::uint32_t priority)
+{
+	auto& container = *resolve(id).slots_;
 	container.pending.emplace_back();
 	auto& info = container.pending.back();
 	info.priority = priority;
-	info.sentinel = sentinel;
-	info.multicast = detail::package_multicast<OArchive, IArchive>(object_ptr, std::forward<F>(f));
-	info.id = generate_id();
+	info.sentinel = std::move(sentinel);
+	info.signature = detail::fn_invoker<F>::signature();
+	info.multicast = detail::package_multicast<OArchive, IArchive>(std::forward<F>(f), info.caches);
+	info.id = acquire_slot(container);
+
+	return info.id;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::disconnect(const View& id, slot_t slot_id)
+{
+	auto find_it = multicast_list_.find(id);
+	if(find_it == std::end(multicast_list_))
+	{
+		return;
+	}
+
+	auto& signal = *find_it->second;
+	auto entry = find_slot(slot_id);
+	if(entry == nullptr || entry->signal != &signal)
+	{
+		return;
+	}
+
+	const auto pending = entry->pending;
+	auto& info = pending ? signal.pending[entry->position] : signal.active[entry->position];
+	release_slot(slot_id);
+	info.id = 0;
+	--signal.live;
+
+	if(pending || signal.depth == 0)
+	{
+		// nothing can be executing it, so release it right away
+		info.sentinel = {};
+		info.multicast = nullptr;
+		info.caches.reset();
+	}
+	else
+	{
+		// just invalidate the sentinel.
+		info.sentinel = Sentinel{};
+		signal.collect_garbage = true;
+	}
+
+	if(!pending)
+	{
+		++signal.garbage;
+	}
+
+	if(signal.depth == 0)
+	{
+		if(signal.live == 0)
+		{
+			release_slots(signal);
+
+			// if it was the last entry just remove it from the list
+			if(!is_resolved(find_it->second))
+			{
+				const auto was_pattern = remove_pattern(signal);
+				multicast_list_.erase(find_it);
+				if(was_pattern)
+				{
+					sweep_cached_signals();
+				}
+			}
+		}
+		else if(signal.garbage * 2 > signal.active.size())
+		{
+			// amortized over the disconnects which left the garbage behind
+			compact(signal);
+		}
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+slot_t binder<OArchive, IArchive, Key, View, Sentinel, Traits>::acquire_slot(slots& signal)
+{
+	std::uint32_t index{};
+	if(free_slots_.empty())
+	{
+		index = std::uint32_t(slot_table_.size());
+		slot_table_.emplace_back();
+	}
+	else
+	{
+		index = free_slots_.back();
+		free_slots_.pop_back();
+	}
+
+	auto& entry = slot_table_[index];
+	entry.signal = &signal;
+	entry.pending = true;
+	entry.position = std::uint32_t(signal.pending.size() - 1);
+	++signal.live;
+
+	return (slot_t(entry.generation) << 32) | index;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto binder<OArchive, IArchive, Key, View, Sentinel, Traits>::find_slot(slot_t slot_id) -> slot_entry*
+{
+	const auto index = slot_index(slot_id);
+	if(index >= slot_table_.size())
+	{
+		return nullptr;
+	}
+
+	auto& entry = slot_table_[index];
+	if(entry.signal == nullptr || entry.generation != slot_generation(slot_id))
+	{
+		return nullptr;
+	}
+	return &entry;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::release_slot(slot_t slot_id)
+{
+	const auto index = slot_index(slot_id);
+	auto& entry = slot_table_[index];
+	entry.signal = nullptr;
+	// generation 0 is never handed out, so a slot id is never 0
+	if(++entry.generation == 0)
+	{
+		entry.generation = 1;
+	}
+	free_slots_.emplace_back(index);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::release_slots(slots& signal)
+{
+	for(const auto& info : signal.active)
+	{
+		if(info.id != 0)
+		{
+			release_slot(info.id);
+		}
+	}
+	for(const auto& info : signal.pending)
+	{
+		if(info.id != 0)
+		{
+			release_slot(info.id);
+		}
+	}
+	signal.active.clear();
+	signal.pending.clear();
+	signal.live = 0;
+	signal.garbage = 0;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::compact(slots& signal)
+{
+	auto& container = signal.active;
+
+	std::size_t alive = 0;
+	for(auto& info : container)
+	{
+		const auto expired = info.sentinel && info.sentinel.value().expired();
+		if(!info.multicast || expired)
+		{
+			if(info.id != 0)
+			{
+				release_slot(info.id);
+				--signal.live;
+			}
+			continue;
+		}
+
+		auto& dst = container[alive];
+		if(&dst != &info)
+		{
+			dst = std::move(info);
+		}
+		slot_table_[slot_index(dst.id)].position = std::uint32_t(alive++);
+	}
+	container.erase(std::begin(container) + std::ptrdiff_t(alive), std::end(container));
+	signal.garbage = 0;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename... Args>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch(const View& id, Args&&... args)
+{
+	dispatch_key(id, std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename T, typename... Args,
+		  typename std::enable_if_t<detail::is_lookup_view<Key, View, T>::value>*>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch(const T& id, Args&&... args)
+{
+	dispatch_key(detail::lookup_view(id), std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename K, typename... Args>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_key(const K& id, Args&&... args)
+{
+	auto find_it = multicast_list_.find(id);
+	if(find_it == std::end(multicast_list_))
+	{
+		if(matches_wildcard(id))
+		{
+			// the new entry caches the matching patterns for the next dispatches
+			dispatch_matching(add_cached_signal(Key(id)), [&](slots& signal) {
+				return dispatch_impl(signal, static_cast<const std::remove_reference_t<Args>&>(args)...);
+			});
+		}
+		return;
+	}
+
+	if(!wildcard_trie_.empty())
+	{
+		dispatch_matching(find_it->second, [&](slots& signal) {
+			return dispatch_impl(signal, static_cast<const std::remove_reference_t<Args>&>(args)...);
+		});
+		return;
+	}
+
+	auto& signal = *find_it->second;
+	if(dispatch_impl(signal, std::forward<Args>(args)...))
+	{
+		erase_if_empty(signal);
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename Dispatch>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_matching(
+	const std::shared_ptr<slots>& entry, Dispatch&& dispatch)
+{
+	// the slots may erase the entry, while the patterns are still to be dispatched
+	auto signal = entry;
+	const auto collected = dispatch(*signal);
+	dispatch_wildcards(*signal, dispatch);
+
+	if(collected || signal->wildcards.empty())
+	{
+		auto& exact_signal = *signal;
+		signal.reset();
+		erase_if_empty(exact_signal);
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename Dispatch>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_wildcards(slots& signal,
+																				 Dispatch&& dispatch)
+{
+	refresh_wildcards(signal);
+
+	// indexed, since a nested dispatch may refresh the list meanwhile
+	for(std::size_t i = 0; i < signal.wildcards.size(); ++i)
+	{
+		auto pattern = signal.wildcards[i].lock();
+		if(pattern && dispatch(*pattern))
+		{
+			auto& pattern_signal = *pattern;
+			pattern.reset();
+			erase_if_empty(pattern_signal);
+		}
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename K>
+bool binder<OArchive, IArchive, Key, View, Sentinel, Traits>::matches_wildcard(const K& id) const
+{
+	const char* data = nullptr;
+	std::size_t size = 0;
+	if(wildcard_trie_.empty() || !detail::topic_of(id, data, size) || wildcard_trie_.is_pattern(data, size))
+	{
+		return false;
+	}
+
+	bool matched = false;
+	wildcard_trie_.match(data, size, [&matched](const std::weak_ptr<slots>&) { matched = true; });
+	return matched;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::refresh_wildcards(slots& signal)
+{
+	if(signal.wildcard_version == wildcard_version_)
+	{
+		return;
+	}
+	signal.wildcard_version = wildcard_version_;
+	signal.wildcards.clear();
+
+	// patterns are not matched against each other
+	const char* data = nullptr;
+	std::size_t size = 0;
+	if(detail::topic_of(signal.id, data, size) && !wildcard_trie_.is_pattern(data, size))
+	{
+		wildcard_trie_.match(data, size, [&signal](const std::weak_ptr<slots>& pattern) {
+			signal.wildcards.emplace_back(pattern);
+		});
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+bool binder<OArchive, IArchive, Key, View, Sentinel, Traits>::remove_pattern(const slots& signal)
+{
+	const char* data = nullptr;
+	std::size_t size = 0;
+	if(!wildcard_trie_.empty() && detail::topic_of(signal.id, data, size) &&
+	   wildcard_trie_.is_pattern(data, size))
+	{
+		wildcard_trie_.erase(data, size);
+		++wildcard_version_;
+		return true;
+	}
+	return false;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto binder<OArchive, IArchive, Key, View, Sentinel, Traits>::add_signal(Key id)
+	-> const std::shared_ptr<slots>&
+{
+	validate_key(id);
+	auto signal = std::make_shared<slots>();
+	signal->id = id;
+	const auto& entry = multicast_list_.emplace(std::move(id), std::move(signal)).first->second;
+
+	const char* data = nullptr;
+	std::size_t size = 0;
+	if(detail::topic_of(entry->id, data, size) && wildcard_trie_.is_pattern(data, size))
+	{
+		wildcard_trie_.insert(data, size, entry);
+		++wildcard_version_;
+	}
+	return entry;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto binder<OArchive, IArchive, Key, View, Sentinel, Traits>::add_cached_signal(Key id)
+	-> const std::shared_ptr<slots>&
+{
+	// evicted once they outnumber the other entries, so a sweep is amortized
+	// over the dispatches which added them
+	if(cached_signals_ >= Traits::wildcard_cache_size && cached_signals_ * 2 >= multicast_list_.size())
+	{
+		sweep_cached_signals();
+	}
+	++cached_signals_;
+	return add_signal(std::move(id));
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::sweep_cached_signals()
+{
+	// entries without slots are only caching their matching patterns, the next
+	// dispatch adds them back if a pattern still matches
+	for(auto it = std::begin(multicast_list_); it != std::end(multicast_list_);)
+	{
+		auto& signal = *it->second;
+		if(signal.active.empty() && signal.pending.empty() && signal.depth == 0 && !is_resolved(it->second))
+		{
+			remove_pattern(signal);
+			it = multicast_list_.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+	cached_signals_ = 0;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::erase_if_empty(slots& signal)
+{
+	if(!signal.active.empty() || !signal.pending.empty())
+	{
+		return;
+	}
+
+	// the slots may have changed the table, so look it up again
+	auto find_it = multicast_list_.find(signal.id);
+	if(find_it != std::end(multicast_list_) && !is_resolved(find_it->second))
+	{
+		// if it was the last entry just remove it from the list
+		const auto was_pattern = remove_pattern(signal);
+		multicast_list_.erase(find_it);
+		if(was_pattern)
+		{
+			sweep_cached_signals();
+		}
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_storage(
+	const View& id, const typename archive_t::storage_t& args)
+{
+	const auto dispatch = [&](slots& signal) { return dispatch_storage_impl(signal, args, true); };
+
+	auto find_it = multicast_list_.find(id);
+	if(find_it == std::end(multicast_list_))
+	{
+		if(matches_wildcard(id))
+		{
+			dispatch_matching(add_cached_signal(Key(id)), dispatch);
+		}
+		return;
+	}
+
+	if(!wildcard_trie_.empty())
+	{
+		dispatch_matching(find_it->second, dispatch);
+		return;
+	}
+
+	auto& signal = *find_it->second;
+	if(dispatch(signal))
+	{
+		erase_if_empty(signal);
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+bool binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_storage_impl(
+	slots& signal, const typename archive_t::storage_t& args, bool flush)
+{
+	if(flush)
+	{
+		flush_pending(signal.active, signal.pending);
+	}
+
+	auto iarchive = archive_t::create_iarchive(args);
+	return dispatch_slots(signal, [&](auto slot) {
+		archive_t::rewind(iarchive);
+		slot->multicast(&iarchive, nullptr, false, slot->caches);
+	});
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename... Args>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::enqueue(const View& id, Args&&... args)
+{
+	auto oarchive = archive_t::create_oarchive();
+	archive_t::pack(oarchive, std::forward<Args>(args)...);
+
+	queue_.emplace_back();
+	auto& event = queue_.back();
+	event.id = Key(id);
+	event.args = archive_t::get_storage(std::move(oarchive));
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+std::size_t binder<OArchive, IArchive, Key, View, Sentinel, Traits>::process_queue()
+{
+	std::vector<queued_event> events;
+	events.swap(queue_);
+
+	try
+	{
+		// chain the events of each signal in one pass, the first one of a chain
+		// starts its batch
+		{
+			typename Traits::template table_t<Key, std::size_t> last_queued;
+			for(std::size_t i = 0; i < events.size(); ++i)
+			{
+				auto& event = events[i];
+				event.next = queued_event::npos;
+
+				auto find_it = last_queued.find(event.id);
+				if(find_it != std::end(last_queued))
+				{
+					events[find_it->second].next = i;
+					find_it->second = i;
+					continue;
+				}
+
+				try
+				{
+					last_queued.emplace(event.id, i);
+				}
+				catch(const std::logic_error&)
+				{
+					// a key the table cannot hold, like a negative dense key, has no slots
+					event.processed = true;
+				}
+			}
+		}
+
+		for(std::size_t batch = 0; batch < events.size(); ++batch)
+		{
+			if(events[batch].processed)
+			{
+				continue;
+			}
+
+			const auto& id = events[batch].id;
+			auto find_it = multicast_list_.find(id);
+			if(find_it == std::end(multicast_list_) && !matches_wildcard(id))
+			{
+				for(auto i = batch; i != queued_event::npos; i = events[i].next)
+				{
+					events[i].processed = true;
+				}
+				continue;
+			}
+
+			// keep the signal alive for the whole batch
+			auto signal = find_it != std::end(multicast_list_) ? find_it->second : add_cached_signal(id);
+
+			// flushed once, so slots connected during the batch wait for the next one
+			flush_pending(signal->active, signal->pending);
+			if(!wildcard_trie_.empty())
+			{
+				refresh_wildcards(*signal);
+				for(const auto& weak_pattern : signal->wildcards)
+				{
+					if(auto pattern = weak_pattern.lock())
+					{
+						flush_pending(pattern->active, pattern->pending);
+					}
+				}
+			}
+
+			bool collected = false;
+			for(auto i = batch; i != queued_event::npos; i = events[i].next)
+			{
+				auto& event = events[i];
+				event.processed = true;
+
+				const auto dispatch = [&](slots& target) {
+					return dispatch_storage_impl(target, event.args, false);
+				};
+				collected |= dispatch(*signal);
+				if(!wildcard_trie_.empty())
+				{
+					dispatch_wildcards(*signal, dispatch);
+				}
+			}
+
+			if(collected)
+			{
+				auto& batch_signal = *signal;
+				signal.reset();
+				erase_if_empty(batch_signal);
+			}
+		}
+	}
+	catch(...)
+	{
+		// put back what was not processed, ahead of anything queued meanwhile
+		events.erase(std::remove_if(std::begin(events), std::end(events),
+									[](const auto& event) { return event.processed; }),
+					 std::end(events));
+		std::move(std::begin(queue_), std::end(queue_), std::back_inserter(events));
+		queue_.swap(events);
+		throw;
+	}
+
+	const auto processed = events.size();
+	if(queue_.empty())
+	{
+		// reuse the capacity
+		events.clear();
+		queue_.swap(events);
+	}
+	return processed;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename... Args>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch(const signal_handle& handle,
+																	   Args&&... args)
+{
+	assert(handle && "dispatching an unresolved signal handle");
+	if(!wildcard_trie_.empty())
+	{
+		dispatch_matching(handle.slots_, [&](slots& signal) {
+			return dispatch_impl(signal, static_cast<const std::remove_reference_t<Args>&>(args)...);
+		});
+		return;
+	}
+
+	dispatch_impl(*handle.slots_, std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto binder<OArchive, IArchive, Key, View, Sentinel, Traits>::resolve(const View& id) -> signal_handle
+{
+	auto find_it = multicast_list_.find(id);
+
+	signal_handle handle;
+	handle.slots_ = find_it != std::end(multicast_list_) ? find_it->second : add_signal(Key(id));
+	return handle;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename... Args>
+inline bool binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_impl(slots& signal,
+																				   Args&&... args)
+{
+	auto& container_pending = signal.pending;
+	auto& container = signal.active;
+	flush_pending(container, container_pending);
+
+	if(container.empty())
+	{
+		return false;
+	}
+
+	const auto signature = detail::signature_of_args<Args...>();
+	const detail::typed_args_t<Args...> typed_args(args...);
+
+	// the archive is created lazily, only if a slot signature does not match
+	hpp::optional<iarchive_t> iarchive;
+	auto invoke = [&](auto it) {
+		const auto& info = *it;
+		if(info.signature == signature)
+		{
+			info.multicast(nullptr, &typed_args, false, info.caches);
+			return;
+		}
+
+		if(iarchive)
+		{
+			archive_t::rewind(iarchive.value());
+		}
+		else
+		{
+			const auto typed_later = std::any_of(std::next(it), std::end(container), [&](const auto& next) {
+				return next.signature == signature;
+			});
+			// copied rather than moved if still needed by a slot later on
+			iarchive = detail::pack_sync<archive_t>(typed_later, std::forward<Args>(args)...);
+		}
+		// the last slot may take over the arguments
+		info.multicast(&iarchive.value(), nullptr, std::next(it) == std::end(container), info.caches);
+	};
+
+	const auto result = dispatch_slots(signal, invoke);
+	if(iarchive)
+	{
+		detail::recycle<archive_t>(std::move(iarchive.value()));
+	}
+	return result;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename Range>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_many(
+	const View& id, const Range& events, dispatch_order order)
+{
+	const auto dispatch = [&](slots& signal) { return dispatch_many_impl(signal, events, order); };
+
+	auto find_it = multicast_list_.find(id);
+	if(find_it == std::end(multicast_list_))
+	{
+		if(matches_wildcard(id))
+		{
+			dispatch_matching(add_cached_signal(Key(id)), dispatch);
+		}
+		return;
+	}
+
+	if(!wildcard_trie_.empty())
+	{
+		dispatch_matching(find_it->second, dispatch);
+		return;
+	}
+
+	auto& signal = *find_it->second;
+	if(dispatch(signal))
+	{
+		erase_if_empty(signal);
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename Range>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_many(
+	const signal_handle& handle, const Range& events, dispatch_order order)
+{
+	assert(handle && "dispatching an unresolved signal handle");
+	if(!wildcard_trie_.empty())
+	{
+		dispatch_matching(handle.slots_,
+						  [&](slots& signal) { return dispatch_many_impl(signal, events, order); });
+		return;
+	}
+
+	dispatch_many_impl(*handle.slots_, events, order);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename Range>
+bool binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_many_impl(
+	slots& signal, const Range& events, dispatch_order order)
+{
+	constexpr static const auto this_func = "dispatch_many";
+
+	auto& depth = signal.depth;
+	auto& container = signal.active;
+	auto& collect_garbage = signal.collect_garbage;
+	flush_pending(container, signal.pending);
+
+	using event_t = std::decay_t<decltype(*std::begin(events))>;
+	using typed_event_t = detail::typed_event<event_t>;
+
+	const auto count = std::size_t(std::distance(std::begin(events), std::end(events)));
+	if(container.empty() || count == 0)
+	{
+		return false;
+	}
+
+	const auto signature = typed_event_t::signature();
+
+	// the archives are created lazily, only if a slot signature does not match
+	std::vector<hpp::optional<iarchive_t>> iarchives(count);
+	auto invoke = [&](const multicast_info& info, std::size_t index, const event_t& event) {
+		if(info.signature == signature)
+		{
+			const typename typed_event_t::args_t typed_args(event);
+			info.multicast(nullptr, &typed_args, false, info.caches);
+			return;
+		}
 
-	return info.id;
-}
+		auto& iarchive = iarchives[index];
+		if(iarchive)
+		{
+			archive_t::rewind(iarchive.value());
+		}
+		else
+		{
+			auto oarchive = archive_t::create_oarchive();
+			hpp::apply([&oarchive](const auto&... args) { archive_t::pack(oarchive, args...); }, event);
+			iarchive = archive_t::create_iarchive(std::move(oarchive));
+		}
+		info.multicast(&iarchive.value(), nullptr, false, info.caches);
+	};
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
-void binder<OArchive, IArchive, Key, View, Sentinel>::disconnect(const View& id, slot_t slot_id)
-{
-	auto find_it = multicast_list_.find(id);
-	if(find_it != std::end(multicast_list_))
 	{
-		const auto& depth = find_it->second.depth;
-		auto& collect_garbage = find_it->second.collect_garbage;
-		auto& container = find_it->second.active;
-		auto& container_pending = find_it->second.pending;
-		const auto predicate = [slot_id](const auto& info) { return info.id == slot_id; };
-
-		auto remove_from_active = [&]() {
-			if(depth == 0)
+		const detail::recycle_scope<archive_t, decltype(iarchives)> recycled(iarchives);
+		const detail::dispatch_depth scope(depth);
+		try
+		{
+			// validate the slots once, keeping their sentinels locked for the whole range
+			std::vector<std::pair<std::size_t, locked_sentinel_t>> ready;
+			ready.reserve(container.size());
+			for(std::size_t i = 0; i < container.size(); ++i)
 			{
-				auto it = std::remove_if(std::begin(container), std::end(container), predicate);
-				if(it != std::end(container))
+				const auto& info = container[i];
+				// disconnected
+				if(!info.multicast)
+				{
+					continue;
+				}
+
+				locked_sentinel_t sentinel{};
+				if(info.sentinel)
 				{
-					container.erase(it, std::end(container));
+					sentinel = info.sentinel.value().lock();
+					if(!sentinel)
+					{
+						collect_garbage = true;
+						continue;
+					}
+					else if(lifetime<locked_sentinel_t>::is_paused(sentinel))
+					{
+						continue;
+					}
+				}
+				ready.emplace_back(i, std::move(sentinel));
+			}
 
-					// if it was the last entry just remove it from the list
-					if(container.empty() && container_pending.empty())
+			// a slot disconnected by a previous call has its id cleared
+			if(order == dispatch_order::slot_major)
+			{
+				for(const auto& slot : ready)
+				{
+					std::size_t index = 0;
+					for(const auto& event : events)
 					{
-						multicast_list_.erase(find_it);
+						const auto& info = container[slot.first];
+						if(info.id == 0)
+						{
+							break;
+						}
+						invoke(info, index++, event);
 					}
-					return true;
 				}
 			}
 			else
 			{
-				auto it = std::find_if(std::begin(container), std::end(container), predicate);
-				if(it != std::end(container))
+				std::size_t index = 0;
+				for(const auto& event : events)
 				{
-					// just invalidate the sentinel.
-					auto& info = *it;
-					info.sentinel = Sentinel{};
-					collect_garbage = true;
-					return true;
+					for(const auto& slot : ready)
+					{
+						const auto& info = container[slot.first];
+						if(info.id != 0)
+						{
+							invoke(info, index, event);
+						}
+					}
+					++index;
 				}
 			}
-
-			return false;
-		};
-
-		// First try the active slots
-		if(!remove_from_active())
+		}
+		catch(const std::exception& e)
 		{
-			// check and erase from pending
-			container_pending.erase(
-				std::remove_if(std::begin(container_pending), std::end(container_pending), predicate),
-				std::end(container_pending));
+			throw std::runtime_error(detail::diagnostic(this_func, signal.id) + e.what());
 		}
 	}
-}
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
-template <typename... Args>
-void binder<OArchive, IArchive, Key, View, Sentinel>::dispatch(const View& id, Args&&... args)
-{
-	dispatch_impl(id, std::forward<Args>(args)...);
+	if(depth == 0 && collect_garbage)
+	{
+		collect_garbage = false;
+		compact(signal);
+		return true;
+	}
+
+	return false;
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
-template <typename... Args>
-inline void binder<OArchive, IArchive, Key, View, Sentinel>::dispatch_impl(const View& id, Args&&... args)
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename Pool, typename... Args>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_parallel(Pool& pool, const View& id,
+																				 Args&&... args)
 {
-	constexpr static const auto this_func = "dispatch";
+	const auto dispatch = [&](slots& signal) {
+		return dispatch_parallel_impl(pool, signal, static_cast<const std::remove_reference_t<Args>&>(args)...);
+	};
 
 	auto find_it = multicast_list_.find(id);
 	if(find_it == std::end(multicast_list_))
 	{
+		if(matches_wildcard(id))
+		{
+			dispatch_matching(add_cached_signal(Key(id)), dispatch);
+		}
 		return;
 	}
-	auto& depth = find_it->second.depth;
-	auto& container_pending = find_it->second.pending;
-	auto& container = find_it->second.active;
-	auto& collect_garbage = find_it->second.collect_garbage;
-	flush_pending(container, container_pending);
 
-	if(container.empty())
+	if(!wildcard_trie_.empty())
 	{
+		dispatch_matching(find_it->second, dispatch);
 		return;
 	}
 
-	// create this outside the loop
-	auto oarchive = archive_t::create_oarchive();
-	archive_t::pack(oarchive, std::forward<Args>(args)...);
-	auto iarchive = archive_t::create_iarchive(std::move(oarchive));
+	auto& signal = *find_it->second;
+	if(dispatch_parallel_impl(pool, signal, std::forward<Args>(args)...))
+	{
+		erase_if_empty(signal);
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename Pool, typename... Args>
+bool binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_parallel_impl(
+	Pool& pool, slots& signal, Args&&... args)
+{
+	constexpr static const auto this_func = "dispatch_parallel";
+
+	auto& depth = signal.depth;
+	auto& container = signal.active;
+	flush_pending(container, signal.pending);
+
+	if(container.empty())
+	{
+		return false;
+	}
+
+	const auto signature = detail::signature_of_args<Args...>();
+	const detail::typed_args_t<Args...> typed_args(args...);
+
+	// packed once, every slot reads it with its own cursor
+	typename archive_t::storage_t storage{};
+	const auto untyped = std::any_of(std::begin(container), std::end(container), [&](const auto& info) {
+		return info.signature != signature;
+	});
+	if(untyped)
+	{
+		auto oarchive = archive_t::create_oarchive();
+		archive_t::pack(oarchive, static_cast<const std::remove_reference_t<Args>&>(args)...);
+		storage = archive_t::get_storage(std::move(oarchive));
+	}
+
+	std::atomic<bool> expired{false};
+	auto invoke = [&](const multicast_info& info) {
+		// disconnected
+		if(!info.multicast)
+		{
+			return;
+		}
+
+		locked_sentinel_t sentinel{};
+		if(info.sentinel)
+		{
+			// Keep sentinel locked until end of call
+			sentinel = info.sentinel.value().lock();
+			if(!sentinel)
+			{
+				expired = true;
+				return;
+			}
+			else if(lifetime<locked_sentinel_t>::is_paused(sentinel))
+			{
+				return;
+			}
+		}
+
+		if(info.signature == signature)
+		{
+			info.multicast(nullptr, &typed_args, false, info.caches);
+		}
+		else
+		{
+			auto iarchive = archive_t::create_iarchive(storage);
+			info.multicast(&iarchive, nullptr, false, info.caches);
+		}
+	};
 
-	++depth;
-	for(const auto& info : container)
 	{
+		const detail::dispatch_depth scope(depth);
 		try
 		{
-			// check if subscriber expired
-			if(info.sentinel)
+			// the slots are ordered by priority, each band is joined before the next one
+			for(auto band = std::begin(container); band != std::end(container);)
 			{
-				// Keep sentinel locked until end of call
-				auto sentinel = info.sentinel.value().lock();
-				if(!sentinel)
-				{
-					collect_garbage = true;
-					continue;
-				}
-				else if(lifetime<decltype(sentinel)>::is_paused(sentinel))
+				auto band_end = std::find_if(band, std::end(container), [&](const auto& info) {
+					return info.priority != band->priority;
+				});
+
+				const auto count = std::size_t(std::distance(band, band_end));
+				if(count == 1)
 				{
-					continue;
+					invoke(*band);
 				}
 				else
 				{
-					info.multicast(iarchive);
+					pool.parallel_for(count,
+									  [&, band](std::size_t i) { invoke(*(band + std::ptrdiff_t(i))); });
 				}
-			}
-			else
-			{
-				info.multicast(iarchive);
+				band = band_end;
 			}
 		}
 		catch(const std::exception& e)
 		{
-			throw std::runtime_error(detail::diagnostic(this_func, id) + e.what());
+			throw std::runtime_error(detail::diagnostic(this_func, signal.id) + e.what());
 		}
+	}
 
-		archive_t::rewind(iarchive);
+	if(expired)
+	{
+		signal.collect_garbage = true;
+	}
+	if(depth == 0 && signal.collect_garbage)
+	{
+		signal.collect_garbage = false;
+		compact(signal);
+		return true;
 	}
 
-	--depth;
+	return false;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename Invoke>
+inline bool binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_slots(slots& signal,
+																						  Invoke&& invoke)
+{
+	constexpr static const auto this_func = "dispatch";
+
+	auto& depth = signal.depth;
+	auto& container = signal.active;
+	auto& collect_garbage = signal.collect_garbage;
 
-	if(depth == 0 && collect_garbage)
 	{
-		collect_garbage = false;
-		container.erase(
-			std::remove_if(std::begin(container), std::end(container),
-						   [](const auto& info) { return info.sentinel && info.sentinel.value().expired(); }),
-			std::end(container));
-		// if it was the last entry just remove it from the list
-		if(container.empty() && container_pending.empty())
+		const detail::dispatch_depth scope(depth);
+		for(auto it = std::begin(container); it != std::end(container); ++it)
 		{
-			multicast_list_.erase(find_it);
+			const auto& info = *it;
+			// disconnected
+			if(!info.multicast)
+			{
+				continue;
+			}
+
+			try
+			{
+				// check if subscriber expired
+				if(info.sentinel)
+				{
+					// Keep sentinel locked until end of call
+					auto sentinel = info.sentinel.value().lock();
+					if(!sentinel)
+					{
+						collect_garbage = true;
+						continue;
+					}
+					else if(lifetime<decltype(sentinel)>::is_paused(sentinel))
+					{
+						continue;
+					}
+					else
+					{
+						invoke(it);
+					}
+				}
+				else
+				{
+					invoke(it);
+				}
+			}
+			catch(const std::exception& e)
+			{
+				throw std::runtime_error(detail::diagnostic(this_func, signal.id) + e.what());
+			}
 		}
 	}
+
+	if(depth == 0 && collect_garbage)
+	{
+		collect_garbage = false;
+		compact(signal);
+		return true;
+	}
+
+	return false;
 }
 /////////////////
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
 template <typename F>
-void binder<OArchive, IArchive, Key, View, Sentinel>::bind(const View& id, F&& f)
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::bind(const View& id, F&& f)
 {
-	auto emp = unicast_list_.emplace(Key(id), unicast_info{});
-	auto& info = emp.first->second;
-	info.unicast = detail::package_unicast<OArchive, IArchive>(std::forward<F>(f));
+	auto& info = bind_impl(id);
+	auto unicast = std::make_shared<unicast_slot>();
+	unicast->invoke = detail::package_unicast<OArchive, IArchive>(std::forward<F>(f), unicast->caches);
+	info.unicast = std::move(unicast);
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
 template <typename C, typename F>
-void binder<OArchive, IArchive, Key, View, Sentinel>::bind(const View& id, C* const object_ptr, F&& f)
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::bind(const View& id, C* const object_ptr, F&& f)
 {
-	auto emp = unicast_list_.emplace(id, unicast_info{});
-	auto& info = emp.first->second;
-	info.unicast = detail::package_unicast<OArchive, IArchive>(object_ptr, std::forward<F>(f));
+	auto& info = bind_impl(id);
+	auto unicast = std::make_shared<unicast_slot>();
+	unicast->invoke = detail::package_unicast<OArchive, IArchive>(object_ptr, std::forward<F>(f), unicast->caches);
+	info.unicast = std::move(unicast);
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
 template <typename F>
-void binder<OArchive, IArchive, Key, View, Sentinel>::bind(const View& id, const Sentinel& sentinel, F&& f)
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::bind(const View& id, const Sentinel& sentinel,
+																   F&& f)
 {
-	auto emp = unicast_list_.emplace(Key(id), unicast_info{});
-	auto& info = emp.first->second;
+	auto& info = bind_impl(id);
 	info.sentinel = sentinel;
-	info.unicast = detail::package_unicast<OArchive, IArchive>(std::forward<F>(f));
+	auto unicast = std::make_shared<unicast_slot>();
+	unicast->invoke = detail::package_unicast<OArchive, IArchive>(std::forward<F>(f), unicast->caches);
+	info.unicast = std::move(unicast);
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
 template <typename C, typename F>
-void binder<OArchive, IArchive, Key, View, Sentinel>::bind(const View& id, const Sentinel& sentinel,
-														   C* const object_ptr, F&& f)
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::bind(const View& id, const Sentinel& sentinel,
+																   C* const object_ptr, F&& f)
 {
-	auto emp = unicast_list_.emplace(Key(id), unicast_info{});
-	auto& info = emp.first->second;
+	auto& info = bind_impl(id);
 	info.sentinel = sentinel;
-	info.unicast = detail::package_unicast<OArchive, IArchive>(object_ptr, std::forward<F>(f));
+	auto unicast = std::make_shared<unicast_slot>();
+	unicast->invoke = detail::package_unicast<OArchive, IArchive>(object_ptr, std::forward<F>(f), unicast->caches);
+	info.unicast = std::move(unicast);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto binder<OArchive, IArchive, Key, View, Sentinel, Traits>::bind_impl(const View& id) -> unicast_info&
+{
+	return *resolve_call(id).info_;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto binder<OArchive, IArchive, Key, View, Sentinel, Traits>::resolve_call(const View& id) -> call_handle
+{
+	auto find_it = unicast_list_.find(id);
+	if(find_it == std::end(unicast_list_))
+	{
+		// the table's key is validated too, it may outlive the view
+		Key key(id);
+		validate_key(key);
+		auto info = std::make_shared<unicast_info>();
+		info->id = key;
+		find_it = unicast_list_.emplace(std::move(key), std::move(info)).first;
+	}
+
+	call_handle handle;
+	handle.info_ = find_it->second;
+	return handle;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+bool binder<OArchive, IArchive, Key, View, Sentinel, Traits>::is_bound(const View& id) const
+{
+	return is_bound_key(id);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename T, typename std::enable_if_t<detail::is_lookup_view<Key, View, T>::value>*>
+bool binder<OArchive, IArchive, Key, View, Sentinel, Traits>::is_bound(const T& id) const
+{
+	return is_bound_key(detail::lookup_view(id));
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
-bool binder<OArchive, IArchive, Key, View, Sentinel>::is_bound(const View& id) const
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename K>
+bool binder<OArchive, IArchive, Key, View, Sentinel, Traits>::is_bound_key(const K& id) const
 {
 	auto it = unicast_list_.find(id);
-	return it != std::end(unicast_list_);
+	return it != std::end(unicast_list_) && it->second->unicast;
 }
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
-void binder<OArchive, IArchive, Key, View, Sentinel>::unbind(const View& id)
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::unbind(const View& id)
 {
 	auto it = unicast_list_.find(id);
 	if(it != std::end(unicast_list_))
 	{
-		unicast_list_.erase(it);
+		if(is_resolved(it->second))
+		{
+			// keep the entry alive for the handles
+			auto& info = *it->second;
+			info.sentinel = {};
+			info.unicast = nullptr;
+		}
+		else
+		{
+			unicast_list_.erase(it);
+		}
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename R, typename... Args>
+decltype(auto) binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call(const View& id, Args&&... args)
+{
+	return call_key<R>(id, std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename R, typename T, typename... Args,
+		  typename std::enable_if_t<detail::is_lookup_view<Key, View, T>::value>*>
+decltype(auto) binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call(const T& id, Args&&... args)
+{
+	return call_key<R>(detail::lookup_view(id), std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename R, typename K, typename... Args>
+decltype(auto) binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call_key(const K& id, Args&&... args)
+{
+	auto it = unicast_list_.find(id);
+	if(it == std::end(unicast_list_) || !it->second->unicast)
+	{
+		// reported like the stored keys, however the id was spelled
+		constexpr static const auto this_func = "call";
+		throw std::runtime_error(detail::diagnostic(this_func, Key(id)) + detail::unbound_message<R>());
 	}
+
+	return call_impl<R>(*it->second, std::forward<Args>(args)...);
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
 template <typename R, typename... Args>
-decltype(auto) binder<OArchive, IArchive, Key, View, Sentinel>::call(const View& id, Args&&... args)
+decltype(auto) binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call(const call_handle& handle,
+																			 Args&&... args)
+{
+	assert(handle && "calling an unresolved call handle");
+	auto& info = *handle.info_;
+	if(!info.unicast)
+	{
+		constexpr static const auto this_func = "call";
+		throw std::runtime_error(detail::diagnostic(this_func, info.id) + detail::unbound_message<R>());
+	}
+
+	return call_impl<R>(info, std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename R, typename Executor, typename... Args>
+std::future<R> binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call_async(
+	Executor& executor, const View& id, Args&&... args)
+{
+	auto it = unicast_list_.find(id);
+	if(it == std::end(unicast_list_) || !it->second->unicast)
+	{
+		constexpr static const auto this_func = "call_async";
+		throw std::runtime_error(detail::diagnostic(this_func, id) + detail::unbound_message<R>());
+	}
+
+	return call_async_impl<R>(executor, *it->second, std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename R, typename Executor, typename... Args>
+std::future<R> binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call_async(
+	Executor& executor, const call_handle& handle, Args&&... args)
+{
+	assert(handle && "calling an unresolved call handle");
+	auto& info = *handle.info_;
+	if(!info.unicast)
+	{
+		constexpr static const auto this_func = "call_async";
+		throw std::runtime_error(detail::diagnostic(this_func, info.id) + detail::unbound_message<R>());
+	}
+
+	return call_async_impl<R>(executor, info, std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename R, typename Executor, typename... Args>
+std::future<R> binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call_async_impl(
+	Executor& executor, unicast_info& info, Args&&... args)
 {
-	return call_impl<R>(id, std::forward<Args>(args)...);
+	static_assert(!std::is_reference<R>::value, "unsupported return by reference (use return by value)");
+
+	using async_call_t = detail::async_call<OArchive, IArchive, Key, Sentinel, unicast_slot, R>;
+
+	// shared, so that the task stays copyable for any executor
+	auto call = std::make_shared<async_call_t>();
+	call->id = info.id;
+	call->sentinel = info.sentinel;
+	call->unicast = info.unicast;
+
+	auto oarchive = archive_t::create_oarchive();
+	archive_t::pack(oarchive, std::forward<Args>(args)...);
+	call->args = archive_t::get_storage(std::move(oarchive));
+
+	auto result = call->promise.get_future();
+	detail::execute(executor, [call]() { call->run(); });
+	return result;
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
 template <typename R, typename... Args, typename std::enable_if_t<!std::is_void<R>::value>*>
-inline R binder<OArchive, IArchive, Key, View, Sentinel>::call_impl(const View& id, Args&&... args)
+inline R binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call_impl(unicast_info& info,
+																			Args&&... args)
 {
 	static_assert(!std::is_reference<R>::value, "unsupported return by reference (use return by value)");
 
 	constexpr static const auto this_func = "call";
 
-	auto it = unicast_list_.find(id);
-	if(it == std::end(unicast_list_))
-	{
-		throw std::runtime_error(detail::diagnostic(this_func, id) +
+	// Keep the sentinel locked until end of call
+	auto sentinel = lock_unicast(info, this_func,
 								 "invoking a non-binded function and expecting a return value");
-	}
-	const auto& info = it->second;
 
 	try
 	{
 		R res{};
 
-		auto oarchive = archive_t::create_oarchive();
-		archive_t::pack(oarchive, std::forward<Args>(args)...);
-		auto iarchive = archive_t::create_iarchive(std::move(oarchive));
-		// check if subscriber expired
-		if(info.sentinel)
-		{
-			// Keep the sentinel locked until end of call
-			auto sentinel = info.sentinel.value().lock();
-			if(!sentinel)
-			{
-				unicast_list_.erase(it);
-				throw std::runtime_error("invoking a non-binded function and expecting a return value");
-			}
-			else
-			{
+		auto iarchive = detail::pack_sync<archive_t>(false, std::forward<Args>(args)...);
 
-				auto result_oarchive = info.unicast(iarchive);
-				auto result_iarchive = archive_t::create_iarchive(std::move(result_oarchive));
-				if(!archive_t::unpack(result_iarchive, res))
-				{
-					throw std::runtime_error("cannot unpack the expected return type");
-				}
-			}
-		}
-		else
+		auto result_oarchive = info.unicast->invoke(iarchive, info.unicast->caches);
+		detail::recycle<archive_t>(std::move(iarchive));
+		auto result_iarchive = archive_t::create_iarchive(std::move(result_oarchive));
+		if(!detail::unpack_last<archive_t>(result_iarchive, res))
 		{
-			auto result_oarchive = info.unicast(iarchive);
-			auto result_iarchive = archive_t::create_iarchive(std::move(result_oarchive));
-			if(!archive_t::unpack(result_iarchive, res))
-			{
-				throw std::runtime_error("cannot unpack the expected return type");
-			}
+			throw std::runtime_error("cannot unpack the expected return type");
 		}
+		detail::recycle<archive_t>(std::move(result_iarchive));
 
 		return res;
 	}
 	catch(const std::exception& e)
 	{
-		throw std::runtime_error(detail::diagnostic(this_func, id) + e.what());
+		throw std::runtime_error(detail::diagnostic(this_func, info.id) + e.what());
 	}
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
 template <typename R, typename... Args, typename std::enable_if_t<std::is_void<R>::value>*>
-inline R binder<OArchive, IArchive, Key, View, Sentinel>::call_impl(const View& id, Args&&... args)
+inline R binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call_impl(unicast_info& info,
+																			Args&&... args)
 {
 	constexpr static const auto this_func = "call";
 
-	auto it = unicast_list_.find(id);
+	// Keep the sentinel locked until end of call
+	auto sentinel = lock_unicast(info, this_func, "invoking a non-binded function");
+
+	try
+	{
+		auto iarchive = detail::pack_sync<archive_t>(false, std::forward<Args>(args)...);
 
-	if(it == std::end(unicast_list_))
+		detail::recycle<archive_t>(info.unicast->invoke(iarchive, info.unicast->caches));
+		detail::recycle<archive_t>(std::move(iarchive));
+	}
+	catch(const std::exception& e)
 	{
-		throw std::runtime_error(detail::diagnostic(this_func, id) + "invoking a non-binded function");
+		throw std::runtime_error(detail::diagnostic(this_func, info.id) + e.what());
 	}
+}
 
-	const auto& info = it->second;
-	try
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto binder<OArchive, IArchive, Key, View, Sentinel, Traits>::lock_unicast(unicast_info& info,
+																		   const char* func,
+																		   const char* expired_msg)
+	-> locked_sentinel_t
+{
+	locked_sentinel_t sentinel{};
+	// check if subscriber expired
+	if(info.sentinel)
 	{
-		auto oarchive = archive_t::create_oarchive();
-		archive_t::pack(oarchive, std::forward<Args>(args)...);
-		auto iarchive = archive_t::create_iarchive(std::move(oarchive));
-		// check if subscriber expired
-		if(info.sentinel)
+		sentinel = info.sentinel.value().lock();
+		if(!sentinel)
 		{
-			// Keep sentinel locked until end of call
-			auto sentinel = info.sentinel.value().lock();
-			if(!sentinel)
+			auto msg = detail::diagnostic(func, info.id) + expired_msg;
+
+			auto it = unicast_list_.find(info.id);
+			if(it != std::end(unicast_list_))
 			{
-				unicast_list_.erase(it);
-				throw std::runtime_error("invoking a non-binded function");
+				if(is_resolved(it->second))
+				{
+					// keep the entry alive for the handles
+					info.sentinel = {};
+					info.unicast = nullptr;
+				}
+				else
+				{
+					unicast_list_.erase(it);
+				}
 			}
+			throw std::runtime_error(msg);
+		}
+	}
+	return sentinel;
+}
 
-			info.unicast(iarchive);
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::clear()
+{
+	// entries referenced by handles are emptied instead of erased
+	for(auto it = std::begin(multicast_list_); it != std::end(multicast_list_);)
+	{
+		release_slots(*it->second);
+		if(is_resolved(it->second))
+		{
+			++it;
 		}
 		else
 		{
-			info.unicast(iarchive);
+			remove_pattern(*it->second);
+			it = multicast_list_.erase(it);
 		}
 	}
-	catch(const std::exception& e)
+	cached_signals_ = 0;
+	for(auto it = std::begin(unicast_list_); it != std::end(unicast_list_);)
 	{
-		throw std::runtime_error(detail::diagnostic(this_func, id) + e.what());
+		if(is_resolved(it->second))
+		{
+			it->second->sentinel = {};
+			it->second->unicast = nullptr;
+			++it;
+		}
+		else
+		{
+			it = unicast_list_.erase(it);
+		}
 	}
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
-void binder<OArchive, IArchive, Key, View, Sentinel>::clear()
-{
-	multicast_list_.clear();
-	unicast_list_.clear();
-}
-
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
-void binder<OArchive, IArchive, Key, View, Sentinel>::flush_pending()
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void binder<OArchive, IArchive, Key, View, Sentinel, Traits>::flush_pending()
 {
 	for(auto& kvp : multicast_list_)
 	{
-		auto& container_pending = kvp.second.pending;
-		auto& container = kvp.second.active;
+		auto& container_pending = kvp.second->pending;
+		auto& container = kvp.second->active;
 
 		flush_pending(container, container_pending);
 	}
 }
 
-template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel>
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
 inline void
-binder<OArchive, IArchive, Key, View, Sentinel>::flush_pending(std::vector<multicast_info>& container,
-															   std::vector<multicast_info>& container_pending)
+binder<OArchive, IArchive, Key, View, Sentinel, Traits>::flush_pending(
+	std::vector<multicast_info>& container, std::vector<multicast_info>& container_pending)
 {
-	if(!container_pending.empty())
+	if(container_pending.empty())
+	{
+		return;
+	}
+
+	// drop the ones disconnected while pending
+	container_pending.erase(std::remove_if(std::begin(container_pending), std::end(container_pending),
+										   [](const auto& info) { return !info.multicast; }),
+							std::end(container_pending));
+
+	const auto by_priority = [](const auto& lhs, const auto& rhs) { return lhs.priority > rhs.priority; };
+
+	// The active slots are already ordered, so only the new batch needs sorting.
+	// Both the sort and the merge are stable, keeping equal priorities in connection order.
+	std::stable_sort(std::begin(container_pending), std::end(container_pending), by_priority);
+
+	const auto active_count = container.size();
+	std::move(std::begin(container_pending), std::end(container_pending), std::back_inserter(container));
+	container_pending.clear();
+
+	auto first_moved = std::begin(container) + std::ptrdiff_t(active_count);
+	const auto middle = first_moved;
+	if(active_count > 0 && middle != std::end(container) && by_priority(*middle, *std::prev(middle)))
 	{
-		std::move(std::begin(container_pending), std::end(container_pending), std::back_inserter(container));
-		container_pending.clear();
+		first_moved = std::upper_bound(std::begin(container), middle, *middle, by_priority);
+		std::inplace_merge(std::begin(container), middle, std::end(container), by_priority);
+	}
 
-		std::sort(std::begin(container), std::end(container),
-				  [](const auto& lhs, const auto& rhs) { return lhs.priority > rhs.priority; });
+	// keep the slot map in sync with the new positions
+	for(auto it = first_moved; it != std::end(container); ++it)
+	{
+		if(it->id != 0)
+		{
+			auto& entry = slot_table_[slot_index(it->id)];
+			entry.pending = false;
+			entry.position = std::uint32_t(it - std::begin(container));
+		}
 	}
 }
 }
@@ -0,0 +1,64 @@
+#pragma once
+#include "archive.h"
+#include "containers/dense_map.hpp"
+#include "containers/flat_hash_map.hpp"
+#include <functional>
+#include <map>
+
+namespace dyno
+{
+
+//-----------------------------------------------------------------------------
+/// Selects the containers backing the binder's signal tables
+/// and the function wrapper used for its slots.
+/// Specialize or derive from it to customize a binder.
+///
+/// The default std::map allocates one node per signal and does an
+/// O(log n) lookup, with a full key comparison at each visited node.
+/// Entries are never moved, and memory grows exactly with the signal count.
+//-----------------------------------------------------------------------------
+struct binder_traits
+{
+	/// Associative container with a transparent find(view).
+	template <typename Key, typename T>
+	using table_t = std::map<Key, T, std::less<>>;
+
+	/// Move-only callable wrapper used for the slots.
+	template <typename Signature>
+	using delegate_t = dyno::delegate_t<Signature>;
+
+	/// Entries without slots a binder keeps for keys matching a wildcard
+	/// pattern, before evicting them.
+	constexpr static std::size_t wildcard_cache_size = 1024;
+};
+
+//-----------------------------------------------------------------------------
+/// Signal tables backed by an open addressing flat_hash_map.
+///
+/// A lookup hashes the view once and usually ends at the first bucket
+/// probed, with a single key comparison. There are no per-signal allocations.
+/// The table costs (sizeof(Key) + sizeof(T) + 1) bytes per bucket and is kept
+/// at most 7/8 full, so a power of two bucket count wastes up to ~60% of
+/// the slots right after growing.
+//-----------------------------------------------------------------------------
+struct flat_binder_traits : binder_traits
+{
+	template <typename Key, typename T>
+	using table_t = flat_hash_map<Key, T>;
+};
+
+//-----------------------------------------------------------------------------
+/// Signal tables for integral and enum keys backed by a dense_map, indexed
+/// by the key itself, so a lookup is a bounds check plus a load.
+/// It costs sizeof(Key) + sizeof(T) + 1 bytes for every key up to the
+/// largest one used. Only fit for small non-negative keys, on connect or bind
+/// negative keys throw std::out_of_range and keys of 65536 or more
+/// std::length_error. Other key types use a std::map.
+//-----------------------------------------------------------------------------
+struct dense_binder_traits : binder_traits
+{
+	template <typename Key, typename T>
+	using table_t =
+		std::conditional_t<is_dense_key<Key>::value, dense_map<Key, T>, binder_traits::table_t<Key, T>>;
+};
+}
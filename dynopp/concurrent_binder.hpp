@@ -0,0 +1,801 @@
+#ifndef DYNO_CONCURRENT_BINDER_HPP
+#define DYNO_CONCURRENT_BINDER_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include "binder.hpp"
+#include "epoch.hpp"
+
+namespace dyno
+{
+
+//-----------------------------------------------------------------------------
+/// Thread safe variant of binder.
+/// - dispatch/call never block. They pin the epoch and read immutable
+///   snapshots of the tables and of the slot lists.
+/// - connect/disconnect/bind/unbind are serialized by a mutex. They publish a
+///   new snapshot and retire the old one to the epoch_domain.
+/// A dispatch sees the slots connected before it started, so a disconnected
+/// slot may still run for dispatches which were already in flight.
+/// Keys are never erased, so handles and the tables stay valid until the
+/// binder is destroyed. Adding a new key copies the table, which is meant for
+/// a set of keys mostly known upfront.
+//-----------------------------------------------------------------------------
+template <typename OArchive, typename IArchive, typename Key = std::string, typename View = Key,
+		  typename Sentinel = std::weak_ptr<void>, typename Traits = binder_traits>
+struct concurrent_binder
+{
+
+public:
+	using oarchive_t = OArchive;
+	using iarchive_t = IArchive;
+	using archive_t = archive<OArchive, IArchive>;
+	using key_t = Key;
+	using view_t = View;
+	using sentinel_t = Sentinel;
+	using traits_t = Traits;
+
+	static_assert(std::is_constructible<Key, View>::value, "key type must be constructable from view type");
+
+private:
+	struct signal_state;
+	struct unicast_state;
+
+public:
+	//-----------------------------------------------------------------------------
+	/// Pre-resolved multicast signal. Stays valid for the lifetime of the binder.
+	//-----------------------------------------------------------------------------
+	struct signal_handle
+	{
+		explicit operator bool() const noexcept
+		{
+			return !!state_;
+		}
+
+	private:
+		friend struct concurrent_binder;
+		std::shared_ptr<signal_state> state_;
+	};
+
+	//-----------------------------------------------------------------------------
+	/// Pre-resolved unicast slot. Stays valid for the lifetime of the binder.
+	//-----------------------------------------------------------------------------
+	struct call_handle
+	{
+		explicit operator bool() const noexcept
+		{
+			return !!state_;
+		}
+
+	private:
+		friend struct concurrent_binder;
+		std::shared_ptr<unicast_state> state_;
+	};
+
+	concurrent_binder();
+	~concurrent_binder();
+	concurrent_binder(const concurrent_binder&) = delete;
+	concurrent_binder& operator=(const concurrent_binder&) = delete;
+
+	//-----------------------------------------------------------------------------
+	/// Connects a multicast slot to a given signal and returns an id to it.
+	//-----------------------------------------------------------------------------
+	template <typename F>
+	slot_t connect(const View& id, F&& f, std::uint32_t priority = 0);
+	template <typename C, typename F>
+	slot_t connect(const View& id, C* const object_ptr, F&& f, std::uint32_t priority = 0);
+	template <typename F>
+	slot_t connect(const View& id, const Sentinel& sentinel, F&& f, std::uint32_t priority = 0);
+	template <typename C, typename F>
+	slot_t connect(const View& id, const Sentinel& sentinel, C* const object_ptr, F&& f,
+				   std::uint32_t priority = 0);
+
+	//-----------------------------------------------------------------------------
+	/// Disconnects a slot via its id.
+	//-----------------------------------------------------------------------------
+	void disconnect(const View& id, slot_t slot_id);
+
+	//-----------------------------------------------------------------------------
+	/// Dispatches a signal with the given args. Can be called from any thread.
+	//-----------------------------------------------------------------------------
+	template <typename... Args>
+	void dispatch(const View& id, Args&&... args);
+	template <typename... Args>
+	void dispatch(const signal_handle& handle, Args&&... args);
+
+	//-----------------------------------------------------------------------------
+	/// Resolves a signal to a handle which can be dispatched without a key lookup.
+	//-----------------------------------------------------------------------------
+	signal_handle resolve(const View& id);
+
+	//-----------------------------------------------------------------------------
+	/// Binds an unicast slot.
+	//-----------------------------------------------------------------------------
+	template <typename F>
+	void bind(const View& id, F&& f);
+	template <typename C, typename F>
+	void bind(const View& id, C* const object_ptr, F&& f);
+	template <typename F>
+	void bind(const View& id, const Sentinel& sentinel, F&& f);
+	template <typename C, typename F>
+	void bind(const View& id, const Sentinel& sentinel, C* const object_ptr, F&& f);
+
+	//-----------------------------------------------------------------------------
+	/// Check if a unicast is bound.
+	//-----------------------------------------------------------------------------
+	bool is_bound(const View& id) const;
+
+	//-----------------------------------------------------------------------------
+	/// Unbinds an unicast slot.
+	//-----------------------------------------------------------------------------
+	void unbind(const View& id);
+
+	//-----------------------------------------------------------------------------
+	/// Calls an unicast slot with the specified args. May return a value.
+	/// Can be called from any thread.
+	//-----------------------------------------------------------------------------
+	template <typename R = void, typename... Args>
+	decltype(auto) call(const View& id, Args&&... args);
+	template <typename R = void, typename... Args>
+	decltype(auto) call(const call_handle& handle, Args&&... args);
+
+	//-----------------------------------------------------------------------------
+	/// Resolves an unicast slot to a handle which can be called without a key lookup.
+	//-----------------------------------------------------------------------------
+	call_handle resolve_call(const View& id);
+
+	//-----------------------------------------------------------------------------
+	/// Disconnects and unbinds everything.
+	//-----------------------------------------------------------------------------
+	void clear();
+
+private:
+	struct multicast_info
+	{
+		slot_t id{};
+		std::uint32_t priority{};
+		hpp::optional<Sentinel> sentinel;
+		const void* signature{};
+		typename Traits::template delegate_t<void(IArchive*, const void*, bool, detail::slot_caches&)> multicast;
+		mutable detail::slot_caches caches;
+	};
+
+	/// immutable once published, the slots are shared between the snapshots
+	struct slot_list
+	{
+		std::vector<std::shared_ptr<const multicast_info>> slots;
+	};
+
+	struct signal_state
+	{
+		~signal_state()
+		{
+			delete list.load();
+		}
+
+		Key id;
+		std::atomic<const slot_list*> list{nullptr};
+	};
+
+	/// immutable once published
+	struct unicast_info
+	{
+		hpp::optional<Sentinel> sentinel;
+		typename Traits::template delegate_t<OArchive(IArchive&, detail::slot_caches&)> unicast;
+		mutable detail::slot_caches caches;
+	};
+
+	struct unicast_state
+	{
+		~unicast_state()
+		{
+			delete info.load();
+		}
+
+		Key id;
+		std::atomic<const unicast_info*> info{nullptr};
+	};
+
+	using multicast_table_t = typename Traits::template table_t<Key, std::shared_ptr<signal_state>>;
+	using unicast_table_t = typename Traits::template table_t<Key, std::shared_ptr<unicast_state>>;
+	using locked_sentinel_t = decltype(std::declval<const Sentinel&>().lock());
+
+	template <typename F>
+	slot_t connect_impl(const View& id, hpp::optional<Sentinel> sentinel, F&& f, std::uint32_t priority);
+
+	template <typename F>
+	void bind_impl(const View& id, hpp::optional<Sentinel> sentinel, F&& f);
+
+	template <typename... Args>
+	void dispatch_impl(const signal_state& signal, Args&&... args);
+
+	template <typename R, typename... Args, typename std::enable_if_t<!std::is_void<R>::value>* = nullptr>
+	R call_impl(const unicast_state& state, Args&&... args);
+
+	template <typename R, typename... Args, typename std::enable_if_t<std::is_void<R>::value>* = nullptr>
+	R call_impl(const unicast_state& state, Args&&... args);
+
+	// writers only, with the mutex held
+	const std::shared_ptr<signal_state>& resolve_impl(const View& id);
+	const std::shared_ptr<unicast_state>& resolve_call_impl(const View& id);
+	void publish(signal_state& signal, const slot_list* list);
+	void publish(unicast_state& state, const unicast_info* info);
+
+	static epoch_domain& domain()
+	{
+		return epoch_domain::instance();
+	}
+
+	std::atomic<const multicast_table_t*> multicast_list_;
+	std::atomic<const unicast_table_t*> unicast_list_;
+
+	/// serializes the writers
+	std::mutex mutex_;
+	slot_t next_slot_{1};
+};
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::concurrent_binder()
+	: multicast_list_(new multicast_table_t())
+	, unicast_list_(new unicast_table_t())
+{
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::~concurrent_binder()
+{
+	// nobody can be reading anymore, the older snapshots were already retired
+	delete multicast_list_.load();
+	delete unicast_list_.load();
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename F>
+slot_t concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::connect(const View& id, F&& f,
+																				   std::uint32_t priority)
+{
+	static_assert(std::is_void<hpp::fn_result_of<F>>::value,
+				  "signals cannot have a return type different from void");
+
+	return connect_impl(id, {}, std::forward<F>(f), priority);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename C, typename F>
+slot_t concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::connect(
+	const View& id, C* const object_ptr, F&& f, std::uint32_t priority)
+{
+	static_assert(std::is_void<hpp::fn_result_of<F>>::value,
+				  "signals cannot have a return type different from void");
+
+	return connect_impl(id, {}, detail::bind_this(object_ptr, std::forward<F>(f)), priority);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename F>
+slot_t concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::connect(
+	const View& id, const Sentinel& sentinel, F&& f, std::uint32_t priority)
+{
+	static_assert(std::is_void<hpp::fn_result_of<F>>::value,
+				  "signals cannot have a return type different from void");
+
+	return connect_impl(id, sentinel, std::forward<F>(f), priority);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename C, typename F>
+slot_t concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::connect(
+	const View& id, const Sentinel& sentinel, C* const object_ptr, F&& f, std::uint32_t priority)
+{
+	static_assert(std::is_void<hpp::fn_result_of<F>>::value,
+				  "signals cannot have a return type different from void");
+
+	return connect_impl(id, sentinel, detail::bind_this(object_ptr, std::forward<F>(f)), priority);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename F>
+slot_t concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::connect_impl(
+	const View& id, hpp::optional<Sentinel> sentinel, F&& f, std::uint32_t priority)
+{
+	auto info = std::make_shared<multicast_info>();
+	info->priority = priority;
+	info->sentinel = std::move(sentinel);
+	info->signature = detail::fn_invoker<F>::signature();
+	info->multicast = detail::package_multicast<OArchive, IArchive>(std::forward<F>(f), info->caches);
+
+	slot_t slot_id{};
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		slot_id = info->id = next_slot_++;
+
+		auto& signal = *resolve_impl(id);
+		auto list = std::make_unique<slot_list>();
+		if(auto current = signal.list.load(std::memory_order_relaxed))
+		{
+			// drop the expired ones while copying anyway
+			list->slots.reserve(current->slots.size() + 1);
+			std::copy_if(std::begin(current->slots), std::end(current->slots),
+						 std::back_inserter(list->slots), [](const auto& slot) {
+							 return !slot->sentinel || !!slot->sentinel.value().lock();
+						 });
+		}
+
+		// keep the slots ordered by priority, equal priorities in connection order
+		const auto by_priority = [](const auto& lhs, const auto& rhs) {
+			return lhs->priority > rhs->priority;
+		};
+		auto& slots = list->slots;
+		auto it = std::upper_bound(std::begin(slots), std::end(slots), info, by_priority);
+		slots.insert(it, std::move(info));
+		publish(signal, list.release());
+	}
+	domain().collect();
+
+	return slot_id;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::disconnect(const View& id,
+																					slot_t slot_id)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		const auto& table = *multicast_list_.load(std::memory_order_relaxed);
+		auto find_it = table.find(id);
+		if(find_it == std::end(table))
+		{
+			return;
+		}
+
+		auto& signal = *find_it->second;
+		auto current = signal.list.load(std::memory_order_relaxed);
+		if(!current)
+		{
+			return;
+		}
+
+		const auto& slots = current->slots;
+		auto slot_it = std::find_if(std::begin(slots), std::end(slots),
+									[slot_id](const auto& slot) { return slot->id == slot_id; });
+		if(slot_it == std::end(slots))
+		{
+			return;
+		}
+
+		auto list = std::make_unique<slot_list>();
+		list->slots.reserve(slots.size() - 1);
+		list->slots.insert(std::end(list->slots), std::begin(slots), slot_it);
+		list->slots.insert(std::end(list->slots), std::next(slot_it), std::end(slots));
+		publish(signal, list->slots.empty() ? nullptr : list.release());
+	}
+	domain().collect();
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename... Args>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch(const View& id,
+																				  Args&&... args)
+{
+	epoch_domain::guard guard(domain());
+
+	const auto& table = *multicast_list_.load(std::memory_order_acquire);
+	auto find_it = table.find(id);
+	if(find_it == std::end(table))
+	{
+		return;
+	}
+
+	dispatch_impl(*find_it->second, std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename... Args>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch(
+	const signal_handle& handle, Args&&... args)
+{
+	assert(handle && "dispatching an unresolved signal handle");
+
+	epoch_domain::guard guard(domain());
+	dispatch_impl(*handle.state_, std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename... Args>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::dispatch_impl(
+	const signal_state& signal, Args&&... args)
+{
+	constexpr static const auto this_func = "dispatch";
+
+	const auto list = signal.list.load(std::memory_order_acquire);
+	if(!list)
+	{
+		return;
+	}
+	const auto& container = list->slots;
+
+	const auto signature = detail::signature_of_args<Args...>();
+	const detail::typed_args_t<Args...> typed_args(args...);
+
+	// the archive is created lazily, only if a slot signature does not match
+	hpp::optional<iarchive_t> iarchive;
+	auto invoke = [&](auto it) {
+		const auto& info = **it;
+		if(info.signature == signature)
+		{
+			info.multicast(nullptr, &typed_args, false, info.caches);
+			return;
+		}
+
+		if(iarchive)
+		{
+			archive_t::rewind(iarchive.value());
+		}
+		else
+		{
+			const auto typed_later = std::any_of(std::next(it), std::end(container), [&](const auto& next) {
+				return next->signature == signature;
+			});
+			// copied rather than moved if still needed by a slot later on
+			iarchive = detail::pack_sync<archive_t>(typed_later, std::forward<Args>(args)...);
+		}
+		// the last slot may take over the arguments
+		info.multicast(&iarchive.value(), nullptr, std::next(it) == std::end(container), info.caches);
+	};
+
+	for(auto it = std::begin(container); it != std::end(container); ++it)
+	{
+		const auto& info = **it;
+		try
+		{
+			// check if subscriber expired
+			if(info.sentinel)
+			{
+				// Keep sentinel locked until end of call
+				auto sentinel = info.sentinel.value().lock();
+				if(!sentinel || lifetime<decltype(sentinel)>::is_paused(sentinel))
+				{
+					continue;
+				}
+				invoke(it);
+			}
+			else
+			{
+				invoke(it);
+			}
+		}
+		catch(const std::exception& e)
+		{
+			throw std::runtime_error(detail::diagnostic(this_func, signal.id) + e.what());
+		}
+	}
+
+	if(iarchive)
+	{
+		detail::recycle<archive_t>(std::move(iarchive.value()));
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::resolve(const View& id)
+	-> signal_handle
+{
+	signal_handle handle;
+	std::lock_guard<std::mutex> lock(mutex_);
+	handle.state_ = resolve_impl(id);
+	return handle;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::resolve_impl(const View& id)
+	-> const std::shared_ptr<signal_state>&
+{
+	const auto current = multicast_list_.load(std::memory_order_relaxed);
+	auto find_it = current->find(id);
+	if(find_it != std::end(*current))
+	{
+		return find_it->second;
+	}
+
+	// the table's key is validated too, it may outlive the view
+	Key key(id);
+	validate_key(key);
+	auto signal = std::make_shared<signal_state>();
+	signal->id = key;
+
+	auto table = std::make_unique<multicast_table_t>(*current);
+	auto& result = table->emplace(std::move(key), std::move(signal)).first->second;
+	multicast_list_.store(table.release(), std::memory_order_release);
+	domain().retire(current);
+	return result;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::publish(signal_state& signal,
+																				 const slot_list* list)
+{
+	domain().retire(signal.list.exchange(list, std::memory_order_acq_rel));
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::publish(unicast_state& state,
+																				 const unicast_info* info)
+{
+	domain().retire(state.info.exchange(info, std::memory_order_acq_rel));
+}
+
+/////////////////
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename F>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::bind(const View& id, F&& f)
+{
+	bind_impl(id, {}, std::forward<F>(f));
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename C, typename F>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::bind(const View& id,
+																			  C* const object_ptr, F&& f)
+{
+	bind_impl(id, {}, detail::bind_this(object_ptr, std::forward<F>(f)));
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename F>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::bind(const View& id,
+																			  const Sentinel& sentinel, F&& f)
+{
+	bind_impl(id, sentinel, std::forward<F>(f));
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename C, typename F>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::bind(
+	const View& id, const Sentinel& sentinel, C* const object_ptr, F&& f)
+{
+	bind_impl(id, sentinel, detail::bind_this(object_ptr, std::forward<F>(f)));
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename F>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::bind_impl(
+	const View& id, hpp::optional<Sentinel> sentinel, F&& f)
+{
+	auto info = std::make_unique<unicast_info>();
+	info->sentinel = std::move(sentinel);
+	info->unicast = detail::package_unicast<OArchive, IArchive>(std::forward<F>(f), info->caches);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		publish(*resolve_call_impl(id), info.release());
+	}
+	domain().collect();
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::resolve_call(const View& id)
+	-> call_handle
+{
+	call_handle handle;
+	std::lock_guard<std::mutex> lock(mutex_);
+	handle.state_ = resolve_call_impl(id);
+	return handle;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+auto concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::resolve_call_impl(const View& id)
+	-> const std::shared_ptr<unicast_state>&
+{
+	const auto current = unicast_list_.load(std::memory_order_relaxed);
+	auto find_it = current->find(id);
+	if(find_it != std::end(*current))
+	{
+		return find_it->second;
+	}
+
+	// the table's key is validated too, it may outlive the view
+	Key key(id);
+	validate_key(key);
+	auto state = std::make_shared<unicast_state>();
+	state->id = key;
+
+	auto table = std::make_unique<unicast_table_t>(*current);
+	auto& result = table->emplace(std::move(key), std::move(state)).first->second;
+	unicast_list_.store(table.release(), std::memory_order_release);
+	domain().retire(current);
+	return result;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+bool concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::is_bound(const View& id) const
+{
+	epoch_domain::guard guard(domain());
+
+	const auto& table = *unicast_list_.load(std::memory_order_acquire);
+	auto it = table.find(id);
+	return it != std::end(table) && it->second->info.load(std::memory_order_acquire) != nullptr;
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::unbind(const View& id)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		const auto& table = *unicast_list_.load(std::memory_order_relaxed);
+		auto it = table.find(id);
+		if(it != std::end(table))
+		{
+			publish(*it->second, nullptr);
+		}
+	}
+	domain().collect();
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename R, typename... Args>
+decltype(auto) concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call(const View& id,
+																						 Args&&... args)
+{
+	epoch_domain::guard guard(domain());
+
+	const auto& table = *unicast_list_.load(std::memory_order_acquire);
+	auto it = table.find(id);
+	if(it == std::end(table))
+	{
+		constexpr static const auto this_func = "call";
+		throw std::runtime_error(detail::diagnostic(this_func, id) + detail::unbound_message<R>());
+	}
+
+	return call_impl<R>(*it->second, std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename R, typename... Args>
+decltype(auto) concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call(
+	const call_handle& handle, Args&&... args)
+{
+	assert(handle && "calling an unresolved call handle");
+
+	epoch_domain::guard guard(domain());
+	return call_impl<R>(*handle.state_, std::forward<Args>(args)...);
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename R, typename... Args, typename std::enable_if_t<!std::is_void<R>::value>*>
+inline R concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call_impl(
+	const unicast_state& state, Args&&... args)
+{
+	static_assert(!std::is_reference<R>::value, "unsupported return by reference (use return by value)");
+
+	constexpr static const auto this_func = "call";
+
+	const auto info = state.info.load(std::memory_order_acquire);
+	if(!info)
+	{
+		throw std::runtime_error(detail::diagnostic(this_func, state.id) + detail::unbound_message<R>());
+	}
+
+	// Keep the sentinel locked until end of call
+	locked_sentinel_t sentinel{};
+	if(info->sentinel)
+	{
+		sentinel = info->sentinel.value().lock();
+		if(!sentinel)
+		{
+			throw std::runtime_error(detail::diagnostic(this_func, state.id) +
+									 "invoking a non-binded function and expecting a return value");
+		}
+	}
+
+	try
+	{
+		R res{};
+
+		auto iarchive = detail::pack_sync<archive_t>(false, std::forward<Args>(args)...);
+
+		auto result_oarchive = info->unicast(iarchive, info->caches);
+		detail::recycle<archive_t>(std::move(iarchive));
+		auto result_iarchive = archive_t::create_iarchive(std::move(result_oarchive));
+		if(!detail::unpack_last<archive_t>(result_iarchive, res))
+		{
+			throw std::runtime_error("cannot unpack the expected return type");
+		}
+		detail::recycle<archive_t>(std::move(result_iarchive));
+
+		return res;
+	}
+	catch(const std::exception& e)
+	{
+		throw std::runtime_error(detail::diagnostic(this_func, state.id) + e.what());
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+template <typename R, typename... Args, typename std::enable_if_t<std::is_void<R>::value>*>
+inline R concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::call_impl(
+	const unicast_state& state, Args&&... args)
+{
+	constexpr static const auto this_func = "call";
+
+	const auto info = state.info.load(std::memory_order_acquire);
+	if(!info)
+	{
+		throw std::runtime_error(detail::diagnostic(this_func, state.id) + detail::unbound_message<R>());
+	}
+
+	// Keep the sentinel locked until end of call
+	locked_sentinel_t sentinel{};
+	if(info->sentinel)
+	{
+		sentinel = info->sentinel.value().lock();
+		if(!sentinel)
+		{
+			throw std::runtime_error(detail::diagnostic(this_func, state.id) +
+									 "invoking a non-binded function");
+		}
+	}
+
+	try
+	{
+		auto iarchive = detail::pack_sync<archive_t>(false, std::forward<Args>(args)...);
+
+		detail::recycle<archive_t>(info->unicast(iarchive, info->caches));
+		detail::recycle<archive_t>(std::move(iarchive));
+	}
+	catch(const std::exception& e)
+	{
+		throw std::runtime_error(detail::diagnostic(this_func, state.id) + e.what());
+	}
+}
+
+template <typename OArchive, typename IArchive, typename Key, typename View, typename Sentinel,
+		  typename Traits>
+void concurrent_binder<OArchive, IArchive, Key, View, Sentinel, Traits>::clear()
+{
+	{
+		// the entries are kept, so handles stay valid
+		std::lock_guard<std::mutex> lock(mutex_);
+		for(const auto& kvp : *multicast_list_.load(std::memory_order_relaxed))
+		{
+			publish(*kvp.second, nullptr);
+		}
+		for(const auto& kvp : *unicast_list_.load(std::memory_order_relaxed))
+		{
+			publish(*kvp.second, nullptr);
+		}
+	}
+	domain().collect();
+}
+}
+
+#endif
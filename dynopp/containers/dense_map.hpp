@@ -0,0 +1,356 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace dyno
+{
+
+// integral and enum keys can index a table directly
+template <typename T>
+using is_dense_key =
+	std::integral_constant<bool, (std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+									 std::is_enum<T>::value>;
+
+constexpr std::size_t default_dense_map_max_size = std::size_t(1) << 16;
+
+//-----------------------------------------------------------------------------
+/// Map from small non-negative integral or enum keys to values, stored in a
+/// vector indexed by the key itself. A lookup is a bounds check plus a load.
+/// - The table grows on demand up to the largest key inserted, so memory is
+///   proportional to the key range rather than to the number of elements.
+/// - Inserting a negative key throws std::out_of_range, a key of MaxSize or
+///   more std::length_error. Looking them up just finds nothing.
+/// - Erasing leaves the bucket empty, so iterators to other elements stay valid.
+///   Inserting may grow and invalidate all iterators and references.
+//-----------------------------------------------------------------------------
+template <typename Key, typename T, std::size_t MaxSize = default_dense_map_max_size>
+class dense_map
+{
+	static_assert(is_dense_key<Key>::value, "dense_map keys must be integral or enum types");
+
+public:
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = std::pair<const Key, T>;
+	using size_type = std::size_t;
+
+private:
+	template <bool Const>
+	class iterator_impl
+	{
+		using map_ptr = std::conditional_t<Const, const dense_map*, dense_map*>;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = dense_map::value_type;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<Const, const value_type&, value_type&>;
+		using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+		iterator_impl() = default;
+		iterator_impl(map_ptr map, size_type idx)
+			: map_(map)
+			, idx_(idx)
+		{
+			skip();
+		}
+		template <bool C = Const, typename std::enable_if<C, int>::type = 0>
+		iterator_impl(const iterator_impl<false>& rhs)
+			: map_(rhs.map_)
+			, idx_(rhs.idx_)
+		{
+		}
+
+		reference operator*() const
+		{
+			return map_->slots_[idx_];
+		}
+		pointer operator->() const
+		{
+			return std::addressof(map_->slots_[idx_]);
+		}
+		iterator_impl& operator++()
+		{
+			++idx_;
+			skip();
+			return *this;
+		}
+		iterator_impl operator++(int)
+		{
+			auto tmp = *this;
+			++(*this);
+			return tmp;
+		}
+		friend bool operator==(const iterator_impl& lhs, const iterator_impl& rhs)
+		{
+			return lhs.idx_ == rhs.idx_;
+		}
+		friend bool operator!=(const iterator_impl& lhs, const iterator_impl& rhs)
+		{
+			return lhs.idx_ != rhs.idx_;
+		}
+
+	private:
+		friend class dense_map;
+		template <bool>
+		friend class iterator_impl;
+
+		void skip()
+		{
+			while(idx_ < map_->capacity_ && !map_->full_[idx_])
+			{
+				++idx_;
+			}
+		}
+
+		map_ptr map_{nullptr};
+		size_type idx_{0};
+	};
+
+public:
+	using iterator = iterator_impl<false>;
+	using const_iterator = iterator_impl<true>;
+
+	dense_map() = default;
+	dense_map(const dense_map& rhs)
+	{
+		if(rhs.capacity_ != 0)
+		{
+			allocate(rhs.capacity_);
+			for(const auto& kvp : rhs)
+			{
+				emplace(kvp.first, kvp.second);
+			}
+		}
+	}
+	dense_map(dense_map&& rhs) noexcept
+	{
+		swap(rhs);
+	}
+	dense_map& operator=(const dense_map& rhs)
+	{
+		if(this != &rhs)
+		{
+			dense_map tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+	dense_map& operator=(dense_map&& rhs) noexcept
+	{
+		if(this != &rhs)
+		{
+			clear();
+			release();
+			swap(rhs);
+		}
+		return *this;
+	}
+	~dense_map()
+	{
+		clear();
+		release();
+	}
+
+	iterator begin() noexcept
+	{
+		return {this, 0};
+	}
+	const_iterator begin() const noexcept
+	{
+		return {this, 0};
+	}
+	iterator end() noexcept
+	{
+		return {this, capacity_};
+	}
+	const_iterator end() const noexcept
+	{
+		return {this, capacity_};
+	}
+
+	bool empty() const noexcept
+	{
+		return size_ == 0;
+	}
+	size_type size() const noexcept
+	{
+		return size_;
+	}
+
+	iterator find(const Key& key)
+	{
+		return {this, find_index(key)};
+	}
+	const_iterator find(const Key& key) const
+	{
+		return {this, find_index(key)};
+	}
+
+	template <typename... Args>
+	std::pair<iterator, bool> emplace(const Key& key, Args&&... args)
+	{
+		const auto idx = index_of(key);
+		if(idx == npos)
+		{
+			throw std::out_of_range("dense_map negative key");
+		}
+		if(idx < capacity_ && full_[idx])
+		{
+			return {iterator(this, idx), false};
+		}
+
+		if(idx >= capacity_)
+		{
+			grow(idx);
+		}
+
+		::new(static_cast<void*>(std::addressof(slots_[idx])))
+			value_type(std::piecewise_construct, std::forward_as_tuple(key),
+					   std::forward_as_tuple(std::forward<Args>(args)...));
+		full_[idx] = true;
+		++size_;
+		return {iterator(this, idx), true};
+	}
+
+	iterator erase(iterator it)
+	{
+		return erase(const_iterator(it));
+	}
+	iterator erase(const_iterator it)
+	{
+		const auto idx = it.idx_;
+		slots_[idx].~value_type();
+		full_[idx] = false;
+		--size_;
+		return {this, idx + 1};
+	}
+
+	size_type erase(const Key& key)
+	{
+		auto idx = find_index(key);
+		if(idx == capacity_)
+		{
+			return 0;
+		}
+		erase(const_iterator(this, idx));
+		return 1;
+	}
+
+	void clear() noexcept
+	{
+		for(size_type i = 0; i < capacity_; ++i)
+		{
+			if(full_[i])
+			{
+				slots_[i].~value_type();
+				full_[i] = false;
+			}
+		}
+		size_ = 0;
+	}
+
+	void swap(dense_map& rhs) noexcept
+	{
+		std::swap(full_, rhs.full_);
+		std::swap(slots_, rhs.slots_);
+		std::swap(capacity_, rhs.capacity_);
+		std::swap(size_, rhs.size_);
+	}
+
+private:
+	/// index of the negative keys, past the end of any table
+	constexpr static size_type npos = std::numeric_limits<size_type>::max();
+
+	template <typename K = Key, typename std::enable_if<std::is_enum<K>::value, int>::type = 0>
+	static size_type index_of(const K& key) noexcept
+	{
+		return index_of(std::underlying_type_t<K>(key));
+	}
+
+	template <typename K = Key,
+			  typename std::enable_if<std::is_integral<K>::value && std::is_signed<K>::value, int>::type = 0>
+	static size_type index_of(const K& key) noexcept
+	{
+		return key < 0 ? npos : size_type(std::make_unsigned_t<K>(key));
+	}
+
+	template <typename K = Key,
+			  typename std::enable_if<std::is_integral<K>::value && !std::is_signed<K>::value, int>::type = 0>
+	static size_type index_of(const K& key) noexcept
+	{
+		return size_type(key);
+	}
+
+	size_type find_index(const Key& key) const noexcept
+	{
+		const auto idx = index_of(key);
+		return idx < capacity_ && full_[idx] ? idx : capacity_;
+	}
+
+	void grow(size_type idx)
+	{
+		if(idx >= MaxSize)
+		{
+			throw std::length_error("dense_map key out of range");
+		}
+
+		auto capacity = capacity_ == 0 ? size_type(8) : capacity_ * 2;
+		while(capacity <= idx)
+		{
+			capacity *= 2;
+		}
+		capacity = std::min(capacity, MaxSize);
+
+		dense_map tmp;
+		tmp.allocate(capacity);
+		for(size_type i = 0; i < capacity_; ++i)
+		{
+			if(full_[i])
+			{
+				auto& kvp = slots_[i];
+				::new(static_cast<void*>(std::addressof(tmp.slots_[i])))
+					value_type(std::piecewise_construct, std::forward_as_tuple(kvp.first),
+							   std::forward_as_tuple(std::move(kvp.second)));
+				tmp.full_[i] = true;
+				++tmp.size_;
+			}
+		}
+		clear();
+		swap(tmp);
+	}
+
+	void allocate(size_type capacity)
+	{
+		full_ = new bool[capacity];
+		std::memset(full_, 0, capacity);
+		slots_ = std::allocator<value_type>{}.allocate(capacity);
+		capacity_ = capacity;
+	}
+
+	void release() noexcept
+	{
+		if(capacity_ != 0)
+		{
+			std::allocator<value_type>{}.deallocate(slots_, capacity_);
+			delete[] full_;
+		}
+		full_ = nullptr;
+		slots_ = nullptr;
+		capacity_ = 0;
+	}
+
+	bool* full_{nullptr};
+	value_type* slots_{nullptr};
+	size_type capacity_{0};
+	size_type size_{0};
+};
+}
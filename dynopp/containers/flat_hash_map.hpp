@@ -0,0 +1,450 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <hpp/type_traits.hpp>
+
+namespace dyno
+{
+
+// detecting string like types (std::string, string_view, ...)
+template <typename T>
+using string_like_expression =
+	decltype(std::declval<const T&>().data() + std::declval<const T&>().size(),
+			 std::declval<typename T::traits_type::char_type>());
+template <typename T>
+using is_string_like = hpp::is_detected<string_like_expression, T>;
+
+//-----------------------------------------------------------------------------
+/// Transparent hasher. Strings and their views hash identically so that
+/// a table keyed by Key can be searched by View without a Key temporary.
+//-----------------------------------------------------------------------------
+struct transparent_hash
+{
+	static std::size_t hash_bytes(const void* data, std::size_t size) noexcept
+	{
+		// 64-bit FNV-1a
+		std::uint64_t hash = 14695981039346656037ull;
+		auto bytes = static_cast<const unsigned char*>(data);
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return static_cast<std::size_t>(hash);
+	}
+
+	static std::size_t mix(std::size_t value) noexcept
+	{
+		// murmur3 finalizer, std::hash of integers is usually the identity
+		auto hash = static_cast<std::uint64_t>(value);
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdull;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb9fe1a85ec53ull;
+		hash ^= hash >> 33;
+		return static_cast<std::size_t>(hash);
+	}
+
+	template <typename T, typename std::enable_if<is_string_like<T>::value, int>::type = 0>
+	std::size_t operator()(const T& val) const noexcept
+	{
+		return hash_bytes(val.data(), val.size() * sizeof(*val.data()));
+	}
+
+	template <typename T, typename std::enable_if<!is_string_like<T>::value, int>::type = 0>
+	std::size_t operator()(const T& val) const noexcept
+	{
+		return mix(std::hash<T>{}(val));
+	}
+
+	std::size_t operator()(const char* val) const noexcept
+	{
+		return hash_bytes(val, std::strlen(val));
+	}
+};
+
+//-----------------------------------------------------------------------------
+/// Open addressing hash map with linear probing.
+/// - Lookups are transparent: find(view) never constructs a Key.
+/// - Every bucket has a 1 byte control tag holding the top 7 bits of the
+///   hash, so most probe mismatches are rejected without touching the keys.
+///   The low bits pick the home bucket and would be shared along a chain.
+/// - Erasing leaves a tombstone, so iterators to other elements stay valid.
+///   Inserting may rehash and invalidate all iterators and references.
+//-----------------------------------------------------------------------------
+template <typename Key, typename T, typename Hash = transparent_hash, typename KeyEqual = std::equal_to<>>
+class flat_hash_map
+{
+public:
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = std::pair<const Key, T>;
+	using size_type = std::size_t;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+
+private:
+	enum : std::uint8_t
+	{
+		ctrl_empty = 0x80,
+		ctrl_deleted = 0xfe
+	};
+
+	template <bool Const>
+	class iterator_impl
+	{
+		using map_ptr = std::conditional_t<Const, const flat_hash_map*, flat_hash_map*>;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = flat_hash_map::value_type;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::conditional_t<Const, const value_type&, value_type&>;
+		using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+		iterator_impl() = default;
+		iterator_impl(map_ptr map, size_type idx)
+			: map_(map)
+			, idx_(idx)
+		{
+			skip();
+		}
+		template <bool C = Const, typename std::enable_if<C, int>::type = 0>
+		iterator_impl(const iterator_impl<false>& rhs)
+			: map_(rhs.map_)
+			, idx_(rhs.idx_)
+		{
+		}
+
+		reference operator*() const
+		{
+			return map_->slots_[idx_];
+		}
+		pointer operator->() const
+		{
+			return std::addressof(map_->slots_[idx_]);
+		}
+		iterator_impl& operator++()
+		{
+			++idx_;
+			skip();
+			return *this;
+		}
+		iterator_impl operator++(int)
+		{
+			auto tmp = *this;
+			++(*this);
+			return tmp;
+		}
+		friend bool operator==(const iterator_impl& lhs, const iterator_impl& rhs)
+		{
+			return lhs.idx_ == rhs.idx_;
+		}
+		friend bool operator!=(const iterator_impl& lhs, const iterator_impl& rhs)
+		{
+			return lhs.idx_ != rhs.idx_;
+		}
+
+	private:
+		friend class flat_hash_map;
+		template <bool>
+		friend class iterator_impl;
+
+		void skip()
+		{
+			while(idx_ < map_->capacity_ && !is_full(map_->ctrl_[idx_]))
+			{
+				++idx_;
+			}
+		}
+
+		map_ptr map_{nullptr};
+		size_type idx_{0};
+	};
+
+public:
+	using iterator = iterator_impl<false>;
+	using const_iterator = iterator_impl<true>;
+
+	flat_hash_map() = default;
+	flat_hash_map(const flat_hash_map& rhs)
+	{
+		reserve(rhs.size_);
+		for(const auto& kvp : rhs)
+		{
+			emplace(kvp.first, kvp.second);
+		}
+	}
+	flat_hash_map(flat_hash_map&& rhs) noexcept
+	{
+		swap(rhs);
+	}
+	flat_hash_map& operator=(const flat_hash_map& rhs)
+	{
+		if(this != &rhs)
+		{
+			flat_hash_map tmp(rhs);
+			swap(tmp);
+		}
+		return *this;
+	}
+	flat_hash_map& operator=(flat_hash_map&& rhs) noexcept
+	{
+		if(this != &rhs)
+		{
+			clear();
+			release();
+			swap(rhs);
+		}
+		return *this;
+	}
+	~flat_hash_map()
+	{
+		clear();
+		release();
+	}
+
+	iterator begin() noexcept
+	{
+		return {this, 0};
+	}
+	const_iterator begin() const noexcept
+	{
+		return {this, 0};
+	}
+	iterator end() noexcept
+	{
+		return {this, capacity_};
+	}
+	const_iterator end() const noexcept
+	{
+		return {this, capacity_};
+	}
+
+	bool empty() const noexcept
+	{
+		return size_ == 0;
+	}
+	size_type size() const noexcept
+	{
+		return size_;
+	}
+
+	template <typename K>
+	iterator find(const K& key)
+	{
+		return {this, find_index(key)};
+	}
+	template <typename K>
+	const_iterator find(const K& key) const
+	{
+		return {this, find_index(key)};
+	}
+
+	template <typename K, typename... Args>
+	std::pair<iterator, bool> emplace(K&& key, Args&&... args)
+	{
+		auto idx = find_index(key);
+		if(idx != capacity_)
+		{
+			return {iterator(this, idx), false};
+		}
+
+		grow_if_needed();
+
+		const auto hash = hasher{}(key);
+		idx = find_insert_index(hash);
+		if(ctrl_[idx] == ctrl_deleted)
+		{
+			--deleted_;
+		}
+		::new(static_cast<void*>(std::addressof(slots_[idx])))
+			value_type(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+					   std::forward_as_tuple(std::forward<Args>(args)...));
+		ctrl_[idx] = fingerprint(hash);
+		++size_;
+		return {iterator(this, idx), true};
+	}
+
+	iterator erase(iterator it)
+	{
+		return erase(const_iterator(it));
+	}
+	iterator erase(const_iterator it)
+	{
+		const auto idx = it.idx_;
+		slots_[idx].~value_type();
+		ctrl_[idx] = ctrl_deleted;
+		--size_;
+		++deleted_;
+		return {this, idx + 1};
+	}
+
+	template <typename K>
+	size_type erase(const K& key)
+	{
+		auto idx = find_index(key);
+		if(idx == capacity_)
+		{
+			return 0;
+		}
+		erase(const_iterator(this, idx));
+		return 1;
+	}
+
+	void clear() noexcept
+	{
+		for(size_type i = 0; i < capacity_; ++i)
+		{
+			if(is_full(ctrl_[i]))
+			{
+				slots_[i].~value_type();
+			}
+			ctrl_[i] = ctrl_empty;
+		}
+		size_ = 0;
+		deleted_ = 0;
+	}
+
+	void reserve(size_type count)
+	{
+		auto capacity = capacity_ == 0 ? size_type(8) : capacity_;
+		while(count > max_load(capacity))
+		{
+			capacity *= 2;
+		}
+		if(capacity != capacity_)
+		{
+			rehash(capacity);
+		}
+	}
+
+	void swap(flat_hash_map& rhs) noexcept
+	{
+		std::swap(ctrl_, rhs.ctrl_);
+		std::swap(slots_, rhs.slots_);
+		std::swap(capacity_, rhs.capacity_);
+		std::swap(size_, rhs.size_);
+		std::swap(deleted_, rhs.deleted_);
+	}
+
+private:
+	static bool is_full(std::uint8_t ctrl) noexcept
+	{
+		return (ctrl & 0x80) == 0;
+	}
+	static std::uint8_t fingerprint(std::size_t hash) noexcept
+	{
+		return static_cast<std::uint8_t>(hash >> (sizeof(std::size_t) * 8 - 7));
+	}
+	static size_type max_load(size_type capacity) noexcept
+	{
+		// 7/8 load factor, counting tombstones
+		return capacity - capacity / 8;
+	}
+
+	template <typename K>
+	size_type find_index(const K& key) const
+	{
+		if(size_ == 0)
+		{
+			return capacity_;
+		}
+		const auto hash = hasher{}(key);
+		const auto tag = fingerprint(hash);
+		const auto mask = capacity_ - 1;
+		for(auto idx = hash & mask;; idx = (idx + 1) & mask)
+		{
+			const auto ctrl = ctrl_[idx];
+			if(ctrl == ctrl_empty)
+			{
+				return capacity_;
+			}
+			if(ctrl == tag && key_equal{}(slots_[idx].first, key))
+			{
+				return idx;
+			}
+		}
+	}
+
+	size_type find_insert_index(std::size_t hash) const noexcept
+	{
+		const auto mask = capacity_ - 1;
+		for(auto idx = hash & mask;; idx = (idx + 1) & mask)
+		{
+			if(!is_full(ctrl_[idx]))
+			{
+				return idx;
+			}
+		}
+	}
+
+	void grow_if_needed()
+	{
+		if(capacity_ == 0)
+		{
+			rehash(8);
+		}
+		else if(size_ + deleted_ + 1 > max_load(capacity_))
+		{
+			// mostly tombstones, so rehashing in place is enough
+			rehash(size_ + 1 > capacity_ / 2 ? capacity_ * 2 : capacity_);
+		}
+	}
+
+	void rehash(size_type capacity)
+	{
+		flat_hash_map tmp;
+		tmp.allocate(capacity);
+		for(size_type i = 0; i < capacity_; ++i)
+		{
+			if(is_full(ctrl_[i]))
+			{
+				auto& kvp = slots_[i];
+				const auto hash = hasher{}(kvp.first);
+				const auto idx = tmp.find_insert_index(hash);
+				auto& key = const_cast<Key&>(kvp.first);
+				::new(static_cast<void*>(std::addressof(tmp.slots_[idx])))
+					value_type(std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+							   std::forward_as_tuple(std::move(kvp.second)));
+				tmp.ctrl_[idx] = fingerprint(hash);
+				++tmp.size_;
+			}
+		}
+		swap(tmp);
+	}
+
+	void allocate(size_type capacity)
+	{
+		ctrl_ = new std::uint8_t[capacity];
+		std::memset(ctrl_, ctrl_empty, capacity);
+		slots_ = std::allocator<value_type>{}.allocate(capacity);
+		capacity_ = capacity;
+	}
+
+	void release() noexcept
+	{
+		if(capacity_ != 0)
+		{
+			std::allocator<value_type>{}.deallocate(slots_, capacity_);
+			delete[] ctrl_;
+		}
+		ctrl_ = nullptr;
+		slots_ = nullptr;
+		capacity_ = 0;
+	}
+
+	std::uint8_t* ctrl_{nullptr};
+	value_type* slots_{nullptr};
+	size_type capacity_{0};
+	size_type size_{0};
+	size_type deleted_{0};
+};
+}
@@ -0,0 +1,266 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace dyno
+{
+
+//-----------------------------------------------------------------------------
+/// Vector keeping up to N elements inline, in the object itself, and moving
+/// them to the heap only when it grows beyond that.
+/// - Moving a vector with its elements inline moves them one by one, so
+///   unlike std::vector it invalidates iterators and references to them.
+/// - Clearing keeps the capacity, heap allocated or not.
+//-----------------------------------------------------------------------------
+template <typename T, std::size_t N>
+class small_vector
+{
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using const_reference = const T&;
+	using pointer = T*;
+	using const_pointer = const T*;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	constexpr static size_type inline_capacity = N;
+
+	small_vector() noexcept = default;
+	small_vector(const small_vector& rhs)
+	{
+		reserve(rhs.size_);
+		for(const auto& element : rhs)
+		{
+			emplace_back(element);
+		}
+	}
+	small_vector(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		take(rhs);
+	}
+	small_vector& operator=(const small_vector& rhs)
+	{
+		if(this != &rhs)
+		{
+			clear();
+			reserve(rhs.size_);
+			for(const auto& element : rhs)
+			{
+				emplace_back(element);
+			}
+		}
+		return *this;
+	}
+	small_vector& operator=(small_vector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		if(this != &rhs)
+		{
+			clear();
+			release();
+			take(rhs);
+		}
+		return *this;
+	}
+	~small_vector()
+	{
+		clear();
+		release();
+	}
+
+	iterator begin() noexcept
+	{
+		return data_;
+	}
+	const_iterator begin() const noexcept
+	{
+		return data_;
+	}
+	iterator end() noexcept
+	{
+		return data_ + size_;
+	}
+	const_iterator end() const noexcept
+	{
+		return data_ + size_;
+	}
+
+	pointer data() noexcept
+	{
+		return data_;
+	}
+	const_pointer data() const noexcept
+	{
+		return data_;
+	}
+
+	reference operator[](size_type idx) noexcept
+	{
+		return data_[idx];
+	}
+	const_reference operator[](size_type idx) const noexcept
+	{
+		return data_[idx];
+	}
+
+	reference back() noexcept
+	{
+		return data_[size_ - 1];
+	}
+	const_reference back() const noexcept
+	{
+		return data_[size_ - 1];
+	}
+
+	bool empty() const noexcept
+	{
+		return size_ == 0;
+	}
+	size_type size() const noexcept
+	{
+		return size_;
+	}
+	size_type capacity() const noexcept
+	{
+		return capacity_;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Whether the elements moved to the heap.
+	//-----------------------------------------------------------------------------
+	bool is_heap() const noexcept
+	{
+		return data_ != inline_data();
+	}
+
+	void reserve(size_type capacity)
+	{
+		if(capacity > capacity_)
+		{
+			relocate(capacity);
+		}
+	}
+
+	template <typename... Args>
+	reference emplace_back(Args&&... args)
+	{
+		if(size_ == capacity_)
+		{
+			// built first, the arguments may refer to the elements about to move
+			T element(std::forward<Args>(args)...);
+			relocate(std::max(capacity_ * 2, size_type(1)));
+			return emplace_back(std::move(element));
+		}
+		auto element = ::new(static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+		++size_;
+		return *element;
+	}
+
+	void push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+	void push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	void pop_back() noexcept
+	{
+		data_[--size_].~T();
+	}
+
+	void clear() noexcept
+	{
+		for(size_type i = 0; i < size_; ++i)
+		{
+			data_[i].~T();
+		}
+		size_ = 0;
+	}
+
+private:
+	T* inline_data() noexcept
+	{
+		return reinterpret_cast<T*>(std::addressof(inline_));
+	}
+	const T* inline_data() const noexcept
+	{
+		return reinterpret_cast<const T*>(std::addressof(inline_));
+	}
+
+	void relocate(size_type capacity)
+	{
+		auto data = std::allocator<T>{}.allocate(capacity);
+		size_type moved = 0;
+		try
+		{
+			for(; moved < size_; ++moved)
+			{
+				::new(static_cast<void*>(data + moved)) T(std::move_if_noexcept(data_[moved]));
+			}
+		}
+		catch(...)
+		{
+			for(size_type i = 0; i < moved; ++i)
+			{
+				data[i].~T();
+			}
+			std::allocator<T>{}.deallocate(data, capacity);
+			throw;
+		}
+
+		const auto size = size_;
+		clear();
+		release();
+		data_ = data;
+		size_ = size;
+		capacity_ = capacity;
+	}
+
+	// expects this to be empty and inline
+	void take(small_vector& rhs)
+	{
+		if(rhs.is_heap())
+		{
+			data_ = rhs.data_;
+			size_ = rhs.size_;
+			capacity_ = rhs.capacity_;
+			rhs.data_ = rhs.inline_data();
+			rhs.size_ = 0;
+			rhs.capacity_ = N;
+			return;
+		}
+
+		for(auto& element : rhs)
+		{
+			emplace_back(std::move(element));
+		}
+		rhs.clear();
+	}
+
+	void release() noexcept
+	{
+		if(is_heap())
+		{
+			std::allocator<T>{}.deallocate(data_, capacity_);
+		}
+		data_ = inline_data();
+		capacity_ = N;
+	}
+
+	std::aligned_storage_t<sizeof(T) * (N == 0 ? 1 : N), alignof(T)> inline_;
+	T* data_{inline_data()};
+	size_type size_{0};
+	size_type capacity_{N};
+};
+
+template <typename T, std::size_t N>
+constexpr typename small_vector<T, N>::size_type small_vector<T, N>::inline_capacity;
+}
@@ -0,0 +1,219 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dyno
+{
+
+//-----------------------------------------------------------------------------
+/// Prefix tree of topic patterns, split into segments on Separator.
+/// In a pattern a '*' segment matches exactly one segment and a trailing '**'
+/// matches one or more, so "net.peer.*" matches "net.peer.a" while "net.**"
+/// matches both "net.peer" and "net.peer.a".
+//-----------------------------------------------------------------------------
+template <typename T, char Separator = '.'>
+class topic_trie
+{
+public:
+	//-----------------------------------------------------------------------------
+	/// Whether the topic has a wildcard segment.
+	//-----------------------------------------------------------------------------
+	static bool is_pattern(const char* data, std::size_t size)
+	{
+		bool found = false;
+		for_each_segment(data, size, [&found](const char* segment, std::size_t length) {
+			found |= is_wildcard(segment, length, 1) || is_wildcard(segment, length, 2);
+		});
+		return found;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Adds a pattern, or replaces the value of an existing one.
+	//-----------------------------------------------------------------------------
+	void insert(const char* data, std::size_t size, T value)
+	{
+		auto current = &root_;
+		for_each_segment(data, size, [&current](const char* segment, std::size_t length) {
+			auto child = current->find(segment, length);
+			if(child == nullptr)
+			{
+				current->children.emplace_back(std::make_unique<node>());
+				child = current->children.back().get();
+				child->segment.assign(segment, length);
+			}
+			current = child;
+		});
+
+		size_ += current->has_value ? 0 : 1;
+		current->has_value = true;
+		current->value = std::move(value);
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Removes a pattern along with the nodes left without patterns.
+	//-----------------------------------------------------------------------------
+	void erase(const char* data, std::size_t size)
+	{
+		std::vector<node*> path{&root_};
+		bool found = true;
+		for_each_segment(data, size, [&](const char* segment, std::size_t length) {
+			auto child = found ? path.back()->find(segment, length) : nullptr;
+			found = child != nullptr;
+			path.push_back(child);
+		});
+		if(!found || !path.back()->has_value)
+		{
+			return;
+		}
+
+		path.back()->has_value = false;
+		path.back()->value = T{};
+		--size_;
+
+		for(auto i = path.size() - 1; i > 0 && path[i]->empty(); --i)
+		{
+			auto& siblings = path[i - 1]->children;
+			for(auto it = std::begin(siblings); it != std::end(siblings); ++it)
+			{
+				if(it->get() == path[i])
+				{
+					siblings.erase(it);
+					break;
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Calls f(value) for every pattern matching the concrete topic, the more
+	/// specific ones first: at every segment an exact match goes before '*',
+	/// which goes before '**'.
+	//-----------------------------------------------------------------------------
+	template <typename F>
+	void match(const char* data, std::size_t size, F&& f) const
+	{
+		if(size_ != 0)
+		{
+			match(root_, data, data + size, f);
+		}
+	}
+
+	bool empty() const noexcept
+	{
+		return size_ == 0;
+	}
+
+	std::size_t size() const noexcept
+	{
+		return size_;
+	}
+
+	void clear()
+	{
+		root_.children.clear();
+		size_ = 0;
+	}
+
+private:
+	struct node
+	{
+		node* find(const char* segment, std::size_t length) const
+		{
+			for(const auto& child : children)
+			{
+				if(child->segment.size() == length && child->segment.compare(0, length, segment, length) == 0)
+				{
+					return child.get();
+				}
+			}
+			return nullptr;
+		}
+
+		bool empty() const noexcept
+		{
+			return !has_value && children.empty();
+		}
+
+		std::string segment;
+		std::vector<std::unique_ptr<node>> children;
+		bool has_value{false};
+		T value{};
+	};
+
+	static bool is_wildcard(const char* segment, std::size_t length, std::size_t stars)
+	{
+		return length == stars && segment[0] == '*' && segment[length - 1] == '*';
+	}
+
+	template <typename F>
+	static void for_each_segment(const char* data, std::size_t size, F&& f)
+	{
+		const auto end = data + size;
+		for(auto first = data;;)
+		{
+			auto last = first;
+			while(last != end && *last != Separator)
+			{
+				++last;
+			}
+			f(first, std::size_t(last - first));
+			if(last == end)
+			{
+				break;
+			}
+			first = last + 1;
+		}
+	}
+
+	template <typename F>
+	static void match(const node& current, const char* first, const char* end, F& f)
+	{
+		auto last = first;
+		while(last != end && *last != Separator)
+		{
+			++last;
+		}
+		const auto length = std::size_t(last - first);
+		const auto next = last == end ? nullptr : last + 1;
+
+		const auto visit = [&](const node* child) {
+			if(child == nullptr)
+			{
+				return;
+			}
+			if(next == nullptr)
+			{
+				if(child->has_value)
+				{
+					f(child->value);
+				}
+			}
+			else
+			{
+				match(*child, next, end, f);
+			}
+		};
+
+		const auto exact = current.find(first, length);
+		visit(exact);
+		const auto any = current.find("*", 1);
+		if(any != exact)
+		{
+			visit(any);
+		}
+
+		// matches the rest of the topic, whatever its length
+		auto rest = current.find("**", 2);
+		if(rest != nullptr && rest->has_value)
+		{
+			f(rest->value);
+		}
+	}
+
+	node root_;
+	std::size_t size_{0};
+};
+}
@@ -0,0 +1,189 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace dyno
+{
+
+constexpr std::size_t default_delegate_capacity = sizeof(void*) * 4;
+
+template <typename Signature, std::size_t Capacity = default_delegate_capacity>
+class inplace_delegate;
+
+//-----------------------------------------------------------------------------
+/// Move-only function wrapper which stores callables of up to 'Capacity'
+/// bytes inside itself. Bigger (or throwing on move) callables fall back to
+/// the heap, so any callable can be stored, but typical slots never allocate.
+//-----------------------------------------------------------------------------
+template <typename R, typename... Args, std::size_t Capacity>
+class inplace_delegate<R(Args...), Capacity>
+{
+	constexpr static std::size_t storage_size = Capacity < sizeof(void*) ? sizeof(void*) : Capacity;
+	using storage_t = std::aligned_storage_t<storage_size, alignof(void*)>;
+
+	struct ops_t
+	{
+		R (*invoke)(void*, Args&&...);
+		void (*move)(void* dst, void* src) noexcept;
+		void (*destroy)(void*) noexcept;
+	};
+
+	template <typename F>
+	using is_inplace =
+		std::integral_constant<bool, sizeof(F) <= storage_size && alignof(F) <= alignof(void*) &&
+										 std::is_nothrow_move_constructible<F>::value>;
+
+	template <typename F>
+	struct inplace_ops
+	{
+		static R invoke(void* storage, Args&&... args)
+		{
+			return (*static_cast<F*>(storage))(std::forward<Args>(args)...);
+		}
+		static void move(void* dst, void* src) noexcept
+		{
+			::new(dst) F(std::move(*static_cast<F*>(src)));
+			static_cast<F*>(src)->~F();
+		}
+		static void destroy(void* storage) noexcept
+		{
+			static_cast<F*>(storage)->~F();
+		}
+		static const ops_t* get() noexcept
+		{
+			static const ops_t ops{&invoke, &move, &destroy};
+			return &ops;
+		}
+	};
+
+	template <typename F>
+	struct heap_ops
+	{
+		static F*& ptr(void* storage) noexcept
+		{
+			return *static_cast<F**>(storage);
+		}
+		static R invoke(void* storage, Args&&... args)
+		{
+			return (*ptr(storage))(std::forward<Args>(args)...);
+		}
+		static void move(void* dst, void* src) noexcept
+		{
+			::new(dst) F*(ptr(src));
+		}
+		static void destroy(void* storage) noexcept
+		{
+			delete ptr(storage);
+		}
+		static const ops_t* get() noexcept
+		{
+			static const ops_t ops{&invoke, &move, &destroy};
+			return &ops;
+		}
+	};
+
+	template <typename F, typename T = std::decay_t<F>>
+	using is_callable = std::integral_constant<bool, !std::is_same<T, inplace_delegate>::value &&
+														 !std::is_same<T, std::nullptr_t>::value>;
+
+public:
+	inplace_delegate() noexcept = default;
+	inplace_delegate(std::nullptr_t) noexcept
+	{
+	}
+	template <typename F, typename std::enable_if<is_callable<F>::value, int>::type = 0>
+	inplace_delegate(F&& f)
+	{
+		emplace(std::forward<F>(f));
+	}
+	inplace_delegate(inplace_delegate&& rhs) noexcept
+	{
+		move_from(rhs);
+	}
+	inplace_delegate(const inplace_delegate&) = delete;
+	inplace_delegate& operator=(const inplace_delegate&) = delete;
+
+	inplace_delegate& operator=(inplace_delegate&& rhs) noexcept
+	{
+		if(this != &rhs)
+		{
+			reset();
+			move_from(rhs);
+		}
+		return *this;
+	}
+	inplace_delegate& operator=(std::nullptr_t) noexcept
+	{
+		reset();
+		return *this;
+	}
+	template <typename F, typename std::enable_if<is_callable<F>::value, int>::type = 0>
+	inplace_delegate& operator=(F&& f)
+	{
+		reset();
+		emplace(std::forward<F>(f));
+		return *this;
+	}
+
+	~inplace_delegate()
+	{
+		reset();
+	}
+
+	R operator()(Args... args) const
+	{
+		if(!ops_)
+		{
+			throw std::bad_function_call();
+		}
+		return ops_->invoke(const_cast<storage_t*>(&storage_), std::forward<Args>(args)...);
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return ops_ != nullptr;
+	}
+
+	void reset() noexcept
+	{
+		if(ops_)
+		{
+			ops_->destroy(&storage_);
+			ops_ = nullptr;
+		}
+	}
+
+private:
+	template <typename F, typename T = std::decay_t<F>,
+			  typename std::enable_if<is_inplace<T>::value, int>::type = 0>
+	void emplace(F&& f)
+	{
+		::new(static_cast<void*>(&storage_)) T(std::forward<F>(f));
+		ops_ = inplace_ops<T>::get();
+	}
+
+	template <typename F, typename T = std::decay_t<F>,
+			  typename std::enable_if<!is_inplace<T>::value, int>::type = 0>
+	void emplace(F&& f)
+	{
+		::new(static_cast<void*>(&storage_)) T*(new T(std::forward<F>(f)));
+		ops_ = heap_ops<T>::get();
+	}
+
+	void move_from(inplace_delegate& rhs) noexcept
+	{
+		if(rhs.ops_)
+		{
+			rhs.ops_->move(&storage_, &rhs.storage_);
+			ops_ = rhs.ops_;
+			rhs.ops_ = nullptr;
+		}
+	}
+
+	storage_t storage_;
+	const ops_t* ops_{nullptr};
+};
+}
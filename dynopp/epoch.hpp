@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace dyno
+{
+
+//-----------------------------------------------------------------------------
+/// Process wide epoch based reclamation.
+/// Readers pin the current epoch while they access shared objects. Writers
+/// unlink an object, then retire it instead of deleting it. A retired object
+/// is deleted once the epoch advanced twice, which can only happen after
+/// every reader that could still see it has unpinned.
+/// - pin/unpin are wait free: two stores on a thread local record.
+/// - retire/collect take a mutex and are meant for the (rare) writers.
+//-----------------------------------------------------------------------------
+class epoch_domain
+{
+	struct record
+	{
+		/// 0 when not pinned, otherwise the pinned epoch
+		std::atomic<std::uint64_t> epoch{0};
+		/// keeps the records of different threads off the same cache line
+		char padding[64 - sizeof(std::atomic<std::uint64_t>)];
+		std::atomic<bool> in_use{false};
+		record* next{nullptr};
+		/// only touched by the owning thread
+		std::uint32_t nesting{0};
+	};
+
+	struct retired
+	{
+		void* ptr;
+		void (*deleter)(void*);
+		std::uint64_t epoch;
+	};
+
+public:
+	//-----------------------------------------------------------------------------
+	/// Keeps the calling thread pinned for its lifetime. Guards can be nested.
+	//-----------------------------------------------------------------------------
+	class guard
+	{
+	public:
+		explicit guard(epoch_domain& domain)
+			: record_(domain.local_record())
+		{
+			if(record_->nesting++ == 0)
+			{
+				const auto epoch = domain.epoch_.load(std::memory_order_relaxed);
+				record_->epoch.store(epoch, std::memory_order_relaxed);
+				// the pinned epoch must be visible before any shared pointer is read
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+			}
+		}
+		~guard()
+		{
+			if(--record_->nesting == 0)
+			{
+				record_->epoch.store(0, std::memory_order_release);
+			}
+		}
+		guard(const guard&) = delete;
+		guard& operator=(const guard&) = delete;
+
+	private:
+		record* record_;
+	};
+
+	static epoch_domain& instance()
+	{
+		static epoch_domain domain;
+		return domain;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Defers the deletion of an already unlinked object.
+	//-----------------------------------------------------------------------------
+	template <typename T>
+	void retire(const T* ptr)
+	{
+		if(ptr)
+		{
+			retire(const_cast<T*>(ptr), [](void* p) { delete static_cast<T*>(p); });
+		}
+	}
+
+	void retire(void* ptr, void (*deleter)(void*))
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const auto epoch = epoch_.load(std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		retired_.push_back({ptr, deleter, epoch});
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Tries to advance the epoch and deletes what is safe to delete.
+	/// Deleters run outside the internal lock, so they may retire themselves.
+	//-----------------------------------------------------------------------------
+	void collect()
+	{
+		try_advance();
+		const auto epoch = epoch_.load(std::memory_order_acquire);
+
+		std::vector<retired> ready;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			auto it = std::partition(std::begin(retired_), std::end(retired_),
+									 [epoch](const retired& r) { return r.epoch + 2 > epoch; });
+			ready.assign(std::make_move_iterator(it), std::make_move_iterator(std::end(retired_)));
+			retired_.erase(it, std::end(retired_));
+		}
+
+		for(const auto& r : ready)
+		{
+			r.deleter(r.ptr);
+		}
+	}
+
+	~epoch_domain()
+	{
+		// no readers can be left at this point
+		for(const auto& r : retired_)
+		{
+			r.deleter(r.ptr);
+		}
+		for(auto rec = records_.load(); rec != nullptr;)
+		{
+			auto next = rec->next;
+			delete rec;
+			rec = next;
+		}
+	}
+
+private:
+	epoch_domain() = default;
+
+	// releases the record of a thread on exit so that it can be reused
+	struct record_owner
+	{
+		record* rec{nullptr};
+		~record_owner()
+		{
+			if(rec)
+			{
+				rec->in_use.store(false, std::memory_order_release);
+			}
+		}
+	};
+
+	record* local_record()
+	{
+		static thread_local record_owner owner;
+		if(!owner.rec)
+		{
+			owner.rec = acquire_record();
+		}
+		return owner.rec;
+	}
+
+	record* acquire_record()
+	{
+		for(auto rec = records_.load(std::memory_order_acquire); rec != nullptr; rec = rec->next)
+		{
+			bool expected = false;
+			if(rec->in_use.compare_exchange_strong(expected, true))
+			{
+				return rec;
+			}
+		}
+
+		auto rec = new record();
+		rec->in_use.store(true, std::memory_order_relaxed);
+		rec->next = records_.load(std::memory_order_relaxed);
+		while(!records_.compare_exchange_weak(rec->next, rec))
+		{
+		}
+		return rec;
+	}
+
+	void try_advance()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto epoch = epoch_.load(std::memory_order_relaxed);
+		for(auto rec = records_.load(std::memory_order_acquire); rec != nullptr; rec = rec->next)
+		{
+			const auto pinned = rec->epoch.load(std::memory_order_acquire);
+			if(pinned != 0 && pinned != epoch)
+			{
+				return;
+			}
+		}
+		epoch_.compare_exchange_strong(epoch, epoch + 1);
+	}
+
+	std::atomic<std::uint64_t> epoch_{1};
+	std::atomic<record*> records_{nullptr};
+	std::mutex mutex_;
+	std::vector<retired> retired_;
+};
+}
@@ -0,0 +1,281 @@
+#ifndef DYNO_EVENT_INBOX_HPP
+#define DYNO_EVENT_INBOX_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#include "binder.hpp"
+
+namespace dyno
+{
+
+//-----------------------------------------------------------------------------
+/// What event_inbox::post does when the inbox is full.
+/// - block: waits for the owner to drain. Never use it from the owning thread.
+/// - drop_newest: the posted event is dropped.
+/// - drop_oldest: the oldest queued event is dropped to make room.
+//-----------------------------------------------------------------------------
+enum class backpressure
+{
+	block,
+	drop_newest,
+	drop_oldest
+};
+
+//-----------------------------------------------------------------------------
+/// Bounded lock-free inbox of pre-packed events for a binder owned by one
+/// thread. Any thread can post, only the owner drains and dispatches.
+/// The ring is allocated upfront and its cells are reused, so apart from the
+/// packing done by the archive posting allocates nothing.
+//-----------------------------------------------------------------------------
+template <typename Binder>
+class event_inbox
+{
+public:
+	using binder_t = Binder;
+	using key_t = typename Binder::key_t;
+	using view_t = typename Binder::view_t;
+	using archive_t = typename Binder::archive_t;
+
+	//-----------------------------------------------------------------------------
+	/// The capacity is rounded up to a power of two.
+	//-----------------------------------------------------------------------------
+	event_inbox(Binder& binder, std::size_t capacity, backpressure policy = backpressure::block);
+	event_inbox(const event_inbox&) = delete;
+	event_inbox& operator=(const event_inbox&) = delete;
+
+	//-----------------------------------------------------------------------------
+	/// Posts a signal with the given args. Can be called from any thread.
+	/// Returns false if the event was dropped.
+	//-----------------------------------------------------------------------------
+	template <typename... Args>
+	bool post(const view_t& id, Args&&... args);
+
+	//-----------------------------------------------------------------------------
+	/// Dispatches up to max_events posted events, in posting order, and returns
+	/// how many were dispatched. Must be called by the thread owning the binder.
+	//-----------------------------------------------------------------------------
+	std::size_t drain(std::size_t max_events = std::numeric_limits<std::size_t>::max());
+
+	//-----------------------------------------------------------------------------
+	/// Number of queued events. Only a snapshot while producers are posting.
+	//-----------------------------------------------------------------------------
+	std::size_t depth() const noexcept;
+
+	//-----------------------------------------------------------------------------
+	/// Number of events dropped because the inbox was full.
+	//-----------------------------------------------------------------------------
+	std::uint64_t dropped() const noexcept;
+
+	std::size_t capacity() const noexcept;
+
+private:
+	struct cell
+	{
+		std::atomic<std::size_t> sequence;
+		key_t id;
+		typename archive_t::storage_t args;
+	};
+
+	template <typename V, typename K = key_t,
+			  typename std::enable_if<std::is_assignable<K&, const V&>::value, int>::type = 0>
+	static void assign_key(K& key, const V& id)
+	{
+		// reuses the storage of the previous key
+		key = id;
+	}
+
+	template <typename V, typename K = key_t,
+			  typename std::enable_if<!std::is_assignable<K&, const V&>::value, int>::type = 0>
+	static void assign_key(K& key, const V& id)
+	{
+		key = K(id);
+	}
+
+	bool try_push(const view_t& id, typename archive_t::storage_t& args);
+
+	template <typename F>
+	bool try_pop(F&& f);
+
+	Binder& binder_;
+	const backpressure policy_;
+	const std::size_t mask_;
+	std::unique_ptr<cell[]> cells_;
+
+	// producers and the consumer work on different cache lines
+	char padding_front_[64];
+	std::atomic<std::size_t> push_pos_{0};
+	char padding_push_[64 - sizeof(std::atomic<std::size_t>)];
+	std::atomic<std::size_t> pop_pos_{0};
+	char padding_pop_[64 - sizeof(std::atomic<std::size_t>)];
+	std::atomic<std::uint64_t> dropped_{0};
+};
+
+namespace detail
+{
+inline std::size_t round_up_pow2(std::size_t value)
+{
+	std::size_t result = 1;
+	while(result < value)
+	{
+		result <<= 1;
+	}
+	return result;
+}
+}
+
+template <typename Binder>
+event_inbox<Binder>::event_inbox(Binder& binder, std::size_t capacity, backpressure policy)
+	: binder_(binder)
+	, policy_(policy)
+	, mask_(detail::round_up_pow2(capacity < 2 ? 2 : capacity) - 1)
+	, cells_(new cell[mask_ + 1])
+{
+	for(std::size_t i = 0; i <= mask_; ++i)
+	{
+		cells_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+template <typename Binder>
+template <typename... Args>
+bool event_inbox<Binder>::post(const view_t& id, Args&&... args)
+{
+	auto oarchive = archive_t::create_oarchive();
+	archive_t::pack(oarchive, std::forward<Args>(args)...);
+	auto storage = archive_t::get_storage(std::move(oarchive));
+
+	while(!try_push(id, storage))
+	{
+		switch(policy_)
+		{
+			case backpressure::block:
+				std::this_thread::yield();
+				break;
+			case backpressure::drop_newest:
+				dropped_.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			case backpressure::drop_oldest:
+				if(try_pop([](cell&) {}))
+				{
+					dropped_.fetch_add(1, std::memory_order_relaxed);
+				}
+				break;
+		}
+	}
+	return true;
+}
+
+template <typename Binder>
+std::size_t event_inbox<Binder>::drain(std::size_t max_events)
+{
+	std::size_t processed = 0;
+	// the event is dispatched in place, its cell is released right after
+	const auto dispatch = [this](cell& event) { binder_.dispatch_storage(event.id, event.args); };
+	while(processed < max_events && try_pop(dispatch))
+	{
+		++processed;
+	}
+	return processed;
+}
+
+template <typename Binder>
+std::size_t event_inbox<Binder>::depth() const noexcept
+{
+	const auto pop_pos = pop_pos_.load(std::memory_order_relaxed);
+	const auto push_pos = push_pos_.load(std::memory_order_relaxed);
+	return push_pos > pop_pos ? push_pos - pop_pos : 0;
+}
+
+template <typename Binder>
+std::uint64_t event_inbox<Binder>::dropped() const noexcept
+{
+	return dropped_.load(std::memory_order_relaxed);
+}
+
+template <typename Binder>
+std::size_t event_inbox<Binder>::capacity() const noexcept
+{
+	return mask_ + 1;
+}
+
+template <typename Binder>
+bool event_inbox<Binder>::try_push(const view_t& id, typename archive_t::storage_t& args)
+{
+	auto pos = push_pos_.load(std::memory_order_relaxed);
+	for(;;)
+	{
+		auto& event = cells_[pos & mask_];
+		const auto sequence = event.sequence.load(std::memory_order_acquire);
+		const auto diff = std::intptr_t(sequence) - std::intptr_t(pos);
+		if(diff == 0)
+		{
+			if(push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				assign_key(event.id, id);
+				event.args = std::move(args);
+				event.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if(diff < 0)
+		{
+			// full
+			return false;
+		}
+		else
+		{
+			pos = push_pos_.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template <typename Binder>
+template <typename F>
+bool event_inbox<Binder>::try_pop(F&& f)
+{
+	auto pos = pop_pos_.load(std::memory_order_relaxed);
+	for(;;)
+	{
+		auto& event = cells_[pos & mask_];
+		const auto sequence = event.sequence.load(std::memory_order_acquire);
+		const auto diff = std::intptr_t(sequence) - std::intptr_t(pos + 1);
+		if(diff == 0)
+		{
+			if(pop_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				// hand the cell back to the producers even if f throws
+				struct release
+				{
+					~release()
+					{
+						event.args = {};
+						event.sequence.store(next, std::memory_order_release);
+					}
+					cell& event;
+					std::size_t next;
+				} guard{event, pos + mask_ + 1};
+
+				f(event);
+				return true;
+			}
+		}
+		else if(diff < 0)
+		{
+			// empty
+			return false;
+		}
+		else
+		{
+			pos = pop_pos_.load(std::memory_order_relaxed);
+		}
+	}
+}
+}
+
+#endif
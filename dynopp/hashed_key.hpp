@@ -0,0 +1,164 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace dyno
+{
+
+//-----------------------------------------------------------------------------
+/// Signal key holding the 64-bit FNV-1a hash of a name, usable as both the
+/// Key and the View of a binder. Lookups compare integers instead of strings,
+/// and keys built from literals are hashed at compile time:
+///
+///     constexpr dyno::hashed_key on_tick("on_tick");
+///     binder.dispatch(on_tick);
+///     binder.dispatch("on_tick"_key);
+///
+/// A key points to the name it was built from, without copying it. The keys
+/// a binder stores are validated, which in debug builds registers their name
+/// by hash, used by the diagnostics, and asserts when two different names hash
+/// the same. Release builds only keep the hash of stored keys.
+/// The layout is the same in both builds, so they can be linked together.
+//-----------------------------------------------------------------------------
+class hashed_key
+{
+public:
+	static constexpr std::uint64_t hash(const char* data, std::size_t size) noexcept
+	{
+		std::uint64_t result = 14695981039346656037ull;
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			result ^= static_cast<unsigned char>(data[i]);
+			result *= 1099511628211ull;
+		}
+		return result;
+	}
+
+	constexpr hashed_key() noexcept = default;
+
+	/// Literals have static storage, so their name is kept without a copy.
+	template <std::size_t N>
+	constexpr hashed_key(const char (&name)[N]) noexcept
+		: hashed_key(name, N - 1)
+	{
+	}
+
+	/// The name must outlive the key, until a binder validates and stores it.
+	constexpr hashed_key(const char* name, std::size_t size) noexcept
+		: hash_(hash(name, size))
+		, name_(name)
+		, size_(size)
+	{
+	}
+
+	hashed_key(const std::string& name) noexcept
+		: hashed_key(name.c_str(), name.size())
+	{
+	}
+
+	constexpr std::uint64_t value() const noexcept
+	{
+		return hash_;
+	}
+
+	//-----------------------------------------------------------------------------
+	/// The name while it is known, the hash in hex otherwise.
+	//-----------------------------------------------------------------------------
+	std::string name() const
+	{
+		if(name_ != nullptr)
+		{
+			return std::string(name_, size_);
+		}
+		std::ostringstream os;
+		os << "#" << std::hex << hash_;
+		return os.str();
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Called by the binders on the keys they store, never on lookups.
+	/// Debug builds point the key to the name registered for its hash, so stored
+	/// keys never outlive it, and assert if that is another name. Release builds
+	/// drop the name, which the key may outlive.
+	//-----------------------------------------------------------------------------
+	void validate()
+	{
+		if(name_ == nullptr)
+		{
+			return;
+		}
+#ifndef NDEBUG
+		auto& names = registry();
+		std::lock_guard<std::mutex> lock(names.mutex);
+		const auto& name = names.registered.emplace(hash_, std::string(name_, size_)).first->second;
+		assert(name.compare(0, name.size(), name_, size_) == 0 && "hashed_key collision");
+		name_ = name.c_str();
+#else
+		name_ = nullptr;
+		size_ = 0;
+#endif
+	}
+
+	friend constexpr bool operator==(const hashed_key& lhs, const hashed_key& rhs) noexcept
+	{
+		return lhs.hash_ == rhs.hash_;
+	}
+	friend constexpr bool operator!=(const hashed_key& lhs, const hashed_key& rhs) noexcept
+	{
+		return lhs.hash_ != rhs.hash_;
+	}
+	friend constexpr bool operator<(const hashed_key& lhs, const hashed_key& rhs) noexcept
+	{
+		return lhs.hash_ < rhs.hash_;
+	}
+
+private:
+	struct names_t
+	{
+		std::mutex mutex;
+		/// names of the keys validated so far, by hash
+		std::unordered_map<std::uint64_t, std::string> registered;
+	};
+
+	static names_t& registry()
+	{
+		static names_t names;
+		return names;
+	}
+
+	std::uint64_t hash_{hash(nullptr, 0)};
+	const char* name_{nullptr};
+	std::size_t size_{0};
+};
+
+inline std::string to_string(const hashed_key& key)
+{
+	return key.name();
+}
+
+namespace literals
+{
+constexpr hashed_key operator"" _key(const char* name, std::size_t size) noexcept
+{
+	return {name, size};
+}
+}
+}
+
+namespace std
+{
+template <>
+struct hash<dyno::hashed_key>
+{
+	std::size_t operator()(const dyno::hashed_key& key) const noexcept
+	{
+		return static_cast<std::size_t>(key.value());
+	}
+};
+}
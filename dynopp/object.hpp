@@ -38,6 +38,9 @@ struct object_rep
 	template <typename T>
 	void set(const View& id, T&& val);
 
+	template <typename T>
+	auto take(const View& id, T& val) -> std::tuple<bool, bool>;
+
 	bool remove(const View& id);
 
 	bool has(const View& id) const;
@@ -85,6 +88,13 @@ public:
 	template <typename T>
 	bool get(const view_t& id, T& val) const;
 
+	//-----------------------------------------------------------------------------
+	/// Moves a field out, removing it, which also works for move-only values.
+	/// A field which cannot be unpacked to T is left as it was.
+	//-----------------------------------------------------------------------------
+	template <typename T>
+	bool take(const view_t& id, T& val);
+
 	//-----------------------------------------------------------------------------
 	/// Checks whether a field exists
 	//-----------------------------------------------------------------------------
@@ -206,6 +216,27 @@ auto object_rep<OArchive, IArchive, Key, View>::get(const View& id, T& val) cons
 	return std::make_tuple(true, unpacked);
 }
 
+template <typename OArchive, typename IArchive, typename Key, typename View>
+template <typename T>
+auto object_rep<OArchive, IArchive, Key, View>::take(const View& id, T& val) -> std::tuple<bool, bool>
+{
+	auto it = impl_.find(id);
+	if(it == std::end(impl_))
+	{
+		return std::make_tuple(false, false);
+	}
+	auto iarchive = archive_t::create_iarchive(std::move(it->second));
+	if(!detail::unpack_last<archive_t>(iarchive, val))
+	{
+		// nothing was moved out, the storage goes back
+		archive_t::rewind(iarchive);
+		it->second = archive_t::get_storage(std::move(iarchive));
+		return std::make_tuple(true, false);
+	}
+	impl_.erase(it);
+	return std::make_tuple(true, true);
+}
+
 template <typename OArchive, typename IArchive, typename Key, typename View>
 bool object_rep<OArchive, IArchive, Key, View>::remove(const View& id)
 {
@@ -253,6 +284,16 @@ bool object<Rep>::get(const view_t& id, T& val) const
 	return exists && unpacked;
 }
 
+template <typename Rep>
+template <typename T>
+bool object<Rep>::take(const view_t& id, T& val)
+{
+	bool exists{};
+	bool unpacked{};
+	std::tie(exists, unpacked) = rep_.take(id, val);
+	return exists && unpacked;
+}
+
 template <typename Rep>
 bool object<Rep>::has(const view_t& id) const
 {
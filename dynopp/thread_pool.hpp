@@ -0,0 +1,243 @@
+#ifndef DYNO_THREAD_POOL_HPP
+#define DYNO_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "delegate.hpp"
+
+namespace dyno
+{
+
+//-----------------------------------------------------------------------------
+/// Work stealing thread pool.
+/// Every worker owns a queue. It pops its own tasks from the back, while idle
+/// workers steal from the front of the others, so uneven tasks balance out.
+//-----------------------------------------------------------------------------
+class thread_pool
+{
+public:
+	using task_t = inplace_delegate<void()>;
+
+	explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency())
+	{
+		const auto count = threads == 0 ? std::size_t(1) : threads;
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			queues_.emplace_back(std::make_unique<worker_queue>());
+		}
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			threads_.emplace_back([this, i]() { worker_loop(i); });
+		}
+	}
+
+	~thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+			stop_ = true;
+		}
+		wake_.notify_all();
+		for(auto& thread : threads_)
+		{
+			thread.join();
+		}
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	std::size_t size() const noexcept
+	{
+		return threads_.size();
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Queues a task. From a worker it goes to its own queue.
+	/// The task must not throw.
+	//-----------------------------------------------------------------------------
+	template <typename F>
+	void submit(F&& f)
+	{
+		const auto index = current_pool() == this ? current_index() : next_queue_++ % queues_.size();
+		push(index, task_t(std::forward<F>(f)));
+		notify();
+	}
+
+	//-----------------------------------------------------------------------------
+	/// Runs f(i) for every i in [0, count) and waits for all of them.
+	/// The calling thread runs tasks too while waiting, so it can be called
+	/// from a task as well. Rethrows the first exception thrown by f.
+	//-----------------------------------------------------------------------------
+	template <typename F>
+	void parallel_for(std::size_t count, const F& f)
+	{
+		struct batch_t
+		{
+			std::atomic<std::size_t> remaining;
+			std::mutex mutex;
+			std::exception_ptr error;
+		} batch;
+		batch.remaining = count;
+
+		const auto first = next_queue_.fetch_add(count);
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			push((first + i) % queues_.size(), [&batch, &f, i]() {
+				try
+				{
+					f(i);
+				}
+				catch(...)
+				{
+					std::lock_guard<std::mutex> lock(batch.mutex);
+					if(!batch.error)
+					{
+						batch.error = std::current_exception();
+					}
+				}
+				batch.remaining.fetch_sub(1, std::memory_order_acq_rel);
+			});
+		}
+		notify();
+
+		const auto index = current_pool() == this ? current_index() : first % queues_.size();
+		while(batch.remaining.load(std::memory_order_acquire) != 0)
+		{
+			task_t task;
+			if(pop(index, task) || steal(index, task))
+			{
+				task();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		if(batch.error)
+		{
+			std::rethrow_exception(batch.error);
+		}
+	}
+
+private:
+	struct worker_queue
+	{
+		std::mutex mutex;
+		std::deque<task_t> tasks;
+	};
+
+	static const thread_pool*& current_pool()
+	{
+		static thread_local const thread_pool* pool = nullptr;
+		return pool;
+	}
+
+	static std::size_t& current_index()
+	{
+		static thread_local std::size_t index = 0;
+		return index;
+	}
+
+	void push(std::size_t index, task_t task)
+	{
+		// counted first, so that it never goes below the number of queued tasks
+		pending_.fetch_add(1, std::memory_order_release);
+		auto& queue = *queues_[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.emplace_back(std::move(task));
+	}
+
+	void notify()
+	{
+		{
+			// pairs with the predicate check of the sleeping workers
+			std::lock_guard<std::mutex> lock(sleep_mutex_);
+		}
+		wake_.notify_all();
+	}
+
+	bool pop(std::size_t index, task_t& task)
+	{
+		auto& queue = *queues_[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if(queue.tasks.empty())
+		{
+			return false;
+		}
+		task = std::move(queue.tasks.back());
+		queue.tasks.pop_back();
+		pending_.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool steal(std::size_t thief, task_t& task)
+	{
+		for(std::size_t i = 1; i < queues_.size(); ++i)
+		{
+			auto& queue = *queues_[(thief + i) % queues_.size()];
+			std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+			if(!lock || queue.tasks.empty())
+			{
+				continue;
+			}
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			pending_.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	void worker_loop(std::size_t index)
+	{
+		current_pool() = this;
+		current_index() = index;
+
+		for(;;)
+		{
+			task_t task;
+			if(pop(index, task) || steal(index, task))
+			{
+				task();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleep_mutex_);
+			if(pending_.load(std::memory_order_acquire) != 0)
+			{
+				// probably a queue we failed to lock, try again
+				lock.unlock();
+				std::this_thread::yield();
+				continue;
+			}
+			if(stop_)
+			{
+				return;
+			}
+			wake_.wait(lock, [this]() { return stop_ || pending_.load(std::memory_order_acquire) != 0; });
+		}
+	}
+
+	std::vector<std::unique_ptr<worker_queue>> queues_;
+	std::vector<std::thread> threads_;
+	std::atomic<std::size_t> next_queue_{0};
+	/// queued tasks, across all the queues
+	std::atomic<std::size_t> pending_{0};
+
+	std::mutex sleep_mutex_;
+	std::condition_variable wake_;
+	bool stop_{false};
+};
+}
+
+#endif
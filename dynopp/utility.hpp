@@ -1,4 +1,5 @@
 #pragma once
+#include <hpp/string_view.hpp>
 #include <hpp/type_traits.hpp>
 #include <hpp/utility.hpp>
 #include <sstream>
@@ -86,4 +87,26 @@ inline std::string make_string(const std::string& p)
 {
 	return "\"" + p + "\"";
 }
+
+inline std::string make_string(hpp::string_view p)
+{
+	return "\"" + std::string(p.data(), p.size()) + "\"";
+}
+
+// Keys able to detect collisions, like hashed_key, are validated when a binder adds them
+template <typename T>
+using validate_expression = decltype(std::declval<T&>().validate());
+template <typename T>
+using has_validate = hpp::is_detected<validate_expression, T>;
+
+template <typename T, typename std::enable_if<has_validate<T>::value, int>::type = 0>
+void validate_key(T& key)
+{
+	key.validate();
+}
+
+template <typename T, typename std::enable_if<!has_validate<T>::value, int>::type = 0>
+void validate_key(T&)
+{
+}
 }
@@ -0,0 +1,8 @@
+#pragma once
+#include <cstddef>
+
+//-----------------------------------------------------------------------------
+/// Number of calls to the global operator new so far, on any thread.
+/// The replacement operators live in their own translation unit.
+//-----------------------------------------------------------------------------
+std::size_t allocation_count();
@@ -1,12 +1,23 @@
+#include "allocation_counter.h"
 #include "json.hpp"
 #include <dynopp/archives/anyarchive.hpp>
 #include <dynopp/binder.hpp>
+#include <dynopp/concurrent_binder.hpp>
+#include <dynopp/event_inbox.hpp>
+#include <dynopp/hashed_key.hpp>
 #include <dynopp/object.hpp>
+#include <dynopp/thread_pool.hpp>
 #include <hpp/string_view.hpp>
 #include <suitepp/suite.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <hpp/utility.hpp>
 #include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
 namespace dyno
 {
 template <typename Key, typename View>
@@ -187,6 +198,2039 @@ void test_binder(const std::string& test, int calls, int slots)
 	};
 }
 
+enum class plugin_event : std::uint16_t
+{
+	system_ready,
+	system_shutdown,
+	frame_end = 200
+};
+
+enum class signed_event : std::int16_t
+{
+	invalid = -1,
+	last = 300
+};
+
+template <typename T>
+void test_binder_dense(const std::string& test, int calls, int slots)
+{
+	TEST_CASE(test + " dense keys")
+	{
+		T binder;
+		int sum = 0;
+		auto id = binder.connect(plugin_event::frame_end, [&sum](int i) { sum += i; });
+		binder.connect(plugin_event::system_ready, [&sum](int i) { sum += i * 10; });
+		binder.bind(plugin_event::system_shutdown, [](int i) { return i * 2; });
+
+		binder.dispatch(plugin_event::frame_end, 1);
+		binder.dispatch(plugin_event::system_ready, 1);
+		binder.dispatch(plugin_event::system_shutdown, 1);
+		EXPECT(sum == 11);
+		EXPECT(binder.template call<int>(plugin_event::system_shutdown, 21) == 42);
+
+		binder.disconnect(plugin_event::frame_end, id);
+		binder.dispatch(plugin_event::frame_end, 1);
+		EXPECT(sum == 11);
+		EXPECT(!binder.is_bound(plugin_event::frame_end));
+		EXPECT_THROWS(binder.call(plugin_event::frame_end));
+	};
+
+	TEST_CASE(test + " integral keys")
+	{
+		using int_binder = dyno::binder<dyno::anystream, dyno::anystream, int, int, std::weak_ptr<void>,
+										typename T::traits_t>;
+		int_binder binder;
+		int sum = 0;
+		binder.connect(3, [&sum](int i) { sum += i; });
+		binder.dispatch(3, 1);
+		EXPECT(sum == 1);
+		binder.dispatch(4, 1);
+		EXPECT(sum == 1);
+	};
+
+	T binder;
+	for(int j = 0; j < slots; ++j)
+	{
+		binder.connect(plugin_event::system_ready, []() {
+			auto a = 0;
+			a++;
+		});
+	}
+
+	binder.bind(plugin_event::system_ready, []() {
+		auto a = 0;
+		a++;
+		return a;
+	});
+
+	binder.flush_pending();
+
+	TEST_CASE(test + " multicast, calls=" + std::to_string(calls) + ", slots=" + std::to_string(slots))
+	{
+		auto code = [&]() {
+			for(int i = 0; i < calls; ++i)
+			{
+				binder.dispatch(plugin_event::system_ready);
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+	};
+
+	TEST_CASE(test + " unicast with return, calls=" + std::to_string(calls))
+	{
+		auto code = [&]() {
+			for(int i = 0; i < calls; ++i)
+			{
+				binder.template call<int>(plugin_event::system_ready);
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+	};
+}
+
+template <typename T, typename Id>
+void test_binder_allocations(const std::string& test, const Id& id)
+{
+	TEST_CASE(test + " lookups allocate nothing")
+	{
+		T binder;
+		int sum = 0;
+		const auto key = typename T::view_t(id);
+		binder.connect(key, [&sum](int i) { sum += i; });
+		binder.bind(key, [](int i) { return i; });
+		// flushes the pending slot
+		binder.dispatch(id, 0);
+
+		const auto before = allocation_count();
+		for(int i = 0; i < 100; ++i)
+		{
+			binder.dispatch(id, 1);
+		}
+		const auto bound = binder.is_bound(id);
+		const auto after = allocation_count();
+
+		EXPECT(bound);
+		EXPECT(sum == 100);
+		EXPECT(after == before);
+	};
+}
+
+struct values_receiver
+{
+	void on_values(long a, double b)
+	{
+		sum += a + long(b);
+	}
+
+	long sum{0};
+};
+
+template <typename T>
+void test_binder_archive_allocations(const std::string& test)
+{
+	TEST_CASE(test + " archives are recycled")
+	{
+		T binder;
+		long sum = 0;
+		// the signatures do not match, so the arguments go through an archive
+		binder.connect("plugin_on_system_ready", [&sum](long i) { sum += i; });
+		binder.bind("plugin_get_version", [](long i) { return i; });
+		binder.dispatch("plugin_on_system_ready", 0);
+		binder.template call<long>("plugin_get_version", 0);
+
+		constexpr int iterations = 100;
+		auto before = allocation_count();
+		for(int i = 0; i < iterations; ++i)
+		{
+			binder.dispatch("plugin_on_system_ready", 1);
+		}
+		const auto dispatch_allocations = allocation_count() - before;
+
+		before = allocation_count();
+		for(int i = 0; i < iterations; ++i)
+		{
+			sum += binder.template call<long>("plugin_get_version", 1);
+		}
+		const auto call_allocations = allocation_count() - before;
+
+		EXPECT(sum == 2 * iterations);
+		// at most what the any of every argument and result costs, never the storage
+		EXPECT(dispatch_allocations <= std::size_t(iterations));
+		EXPECT(call_allocations <= std::size_t(2 * iterations));
+	};
+
+	TEST_CASE(test + " member slots with converted arguments are stored inplace")
+	{
+		T binder;
+		values_receiver receiver;
+		// leaves room in the signal's containers and a free slot id for the slot below
+		binder.connect("on_values", [](long, double) {});
+		auto spare = binder.connect("on_values", [](long, double) {});
+		binder.dispatch("on_values", 1, 2);
+		binder.disconnect("on_values", spare);
+
+		const auto before = allocation_count();
+		binder.connect("on_values", &receiver, &values_receiver::on_values);
+		const auto connect_allocations = allocation_count() - before;
+
+		// the ints are converted through the archive, filling the slot's caches
+		binder.dispatch("on_values", 1, 2);
+		binder.dispatch("on_values", 1, 2);
+		EXPECT(receiver.sum == 6);
+		EXPECT(connect_allocations == 0);
+	};
+}
+
+template <typename T>
+void test_binder_payload_allocations(const std::string& test, int dispatches, std::size_t max_allocations)
+{
+	TEST_CASE(test + " vector<string> payload allocations, dispatches=" + std::to_string(dispatches))
+	{
+		T binder;
+		std::size_t received = 0;
+		// the signature does not match, so the payload goes through the archive
+		binder.connect("on_names", [&received](const std::vector<std::string>& names, long) {
+			received += names.size();
+		});
+		const std::vector<std::string> names{"str1", "str2", "str3"};
+		binder.dispatch("on_names", names, 0);
+
+		const auto before = allocation_count();
+		for(int i = 0; i < dispatches; ++i)
+		{
+			binder.dispatch("on_names", names, 1);
+		}
+		const auto allocations = allocation_count() - before;
+
+		EXPECT(received == names.size() * std::size_t(dispatches + 1));
+		EXPECT(allocations <= max_allocations * std::size_t(dispatches));
+	};
+}
+
+template <typename T>
+void test_binder_handles(const std::string& test, int calls, int slots)
+{
+	T binder;
+	auto signal = binder.resolve("plugin_on_system_ready");
+	auto unicast = binder.resolve_call("plugin_on_system_ready");
+
+	int dispatched = 0;
+	std::vector<dyno::slot_t> ids;
+	for(int j = 0; j < slots; ++j)
+	{
+		ids.emplace_back(binder.connect("plugin_on_system_ready", [&dispatched]() { dispatched++; }));
+	}
+
+	binder.bind("plugin_on_system_ready", [](int a) { return a + 1; });
+
+	TEST_CASE(test + " multicast handle, calls=" + std::to_string(calls) + ", slots=" + std::to_string(slots))
+	{
+		auto code = [&]() {
+			for(int i = 0; i < calls; ++i)
+			{
+				binder.dispatch(signal);
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+		EXPECT(dispatched == calls * slots);
+	};
+
+	TEST_CASE(test + " unicast handle, calls=" + std::to_string(calls))
+	{
+		auto code = [&]() {
+			for(int i = 0; i < calls; ++i)
+			{
+				binder.template call<int>(unicast, i);
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+		EXPECT(binder.template call<int>(unicast, 1) == 2);
+	};
+
+	TEST_CASE(test + " handles survive disconnect/unbind")
+	{
+		for(auto id : ids)
+		{
+			binder.disconnect("plugin_on_system_ready", id);
+		}
+		binder.unbind("plugin_on_system_ready");
+		EXPECT(!binder.is_bound("plugin_on_system_ready"));
+		EXPECT_THROWS(binder.call(unicast, 1));
+
+		std::string message;
+		try
+		{
+			binder.template call<int>("plugin_on_system_ready", 1);
+		}
+		catch(const std::exception& e)
+		{
+			message = e.what();
+		}
+		EXPECT(message.find("expecting a return value") != std::string::npos);
+
+		// the key is reported the same way whether it came as a literal or a string
+		std::string string_message;
+		try
+		{
+			binder.template call<int>(std::string("plugin_on_system_ready"), 1);
+		}
+		catch(const std::exception& e)
+		{
+			string_message = e.what();
+		}
+		EXPECT(message == string_message);
+
+		dispatched = 0;
+		binder.dispatch(signal);
+		EXPECT(dispatched == 0);
+
+		binder.connect("plugin_on_system_ready", [&dispatched]() { dispatched++; });
+		binder.bind("plugin_on_system_ready", [](int a) { return a + 2; });
+
+		binder.dispatch(signal);
+		EXPECT(dispatched == 1);
+		EXPECT(binder.template call<int>(unicast, 1) == 3);
+	};
+}
+
+struct copy_counter
+{
+	copy_counter() = default;
+	copy_counter(const copy_counter& rhs)
+		: copies(rhs.copies)
+	{
+		++(*copies);
+	}
+	copy_counter& operator=(const copy_counter& rhs)
+	{
+		copies = rhs.copies;
+		++(*copies);
+		return *this;
+	}
+	copy_counter(copy_counter&&) = default;
+	copy_counter& operator=(copy_counter&&) = default;
+
+	std::shared_ptr<int> copies = std::make_shared<int>(0);
+};
+
+template <typename T>
+void test_binder_typed(const std::string& test, int slots)
+{
+	TEST_CASE(test + " typed fast path, slots=" + std::to_string(slots))
+	{
+		T binder;
+		int sum = 0;
+		for(int j = 0; j < slots; ++j)
+		{
+			binder.connect("on_value", [&sum](const copy_counter&, int a) { sum += a; });
+		}
+
+		copy_counter counter;
+		binder.dispatch("on_value", counter, 1);
+		EXPECT(sum == slots);
+		EXPECT(*counter.copies == 0);
+
+		// mismatched signatures still go through the archive
+		double dsum = 0.0;
+		binder.connect("on_value", [&dsum](const copy_counter&, double a) { dsum += a; });
+		binder.dispatch("on_value", counter, 2);
+		EXPECT(sum == slots * 3);
+		EXPECT(dsum == 2.0);
+		// but borrowed, so const references are not copied and values only once
+		EXPECT(*counter.copies == 0);
+		binder.connect("on_value", [](copy_counter, double) {});
+		binder.dispatch("on_value", counter, 3);
+		EXPECT(*counter.copies == 1);
+
+		binder.bind("get_value", [](const copy_counter& c, double a) { return *c.copies + a; });
+		EXPECT(binder.template call<double>("get_value", counter, 1) == 2.0);
+		EXPECT(*counter.copies == 1);
+
+		// queued arguments are copied once into the archive, which every slot then refers to
+		int queued = 0;
+		for(int j = 0; j < slots; ++j)
+		{
+			binder.connect("on_queued", [&queued](const copy_counter&, long) { ++queued; });
+		}
+		copy_counter stored;
+		binder.enqueue("on_queued", stored, 1);
+		binder.process_queue();
+		EXPECT(queued == slots);
+		EXPECT(*stored.copies == 1);
+
+		// non-const references receive a copy, as they would from an archive
+		int value = 1;
+		binder.connect("on_ref", [](int& a) { a = 42; });
+		binder.dispatch("on_ref", value);
+		EXPECT(value == 1);
+
+		std::string str;
+		binder.connect("on_str", [&str](const std::string& a) { str = a; });
+		binder.dispatch("on_str", "literal");
+		EXPECT(str == "literal");
+
+		// the conversions a slot remembers follow the dispatched types
+		double converted = 0.0;
+		binder.connect("on_double", [&converted](double a) { converted += a; });
+		binder.dispatch("on_double", 1);
+		binder.dispatch("on_double", 1);
+		binder.dispatch("on_double", 0.5f);
+		binder.dispatch("on_double", 0.5);
+		binder.dispatch("on_double", 1);
+		EXPECT(converted == 4.0);
+		EXPECT_THROWS(binder.dispatch("on_double", std::string("1")));
+	};
+}
+
+struct move_counter
+{
+	move_counter() = default;
+	move_counter(const move_counter& rhs)
+		: copies(rhs.copies)
+		, moves(rhs.moves)
+	{
+		++(*copies);
+	}
+	move_counter(move_counter&& rhs)
+		: copies(rhs.copies)
+		, moves(rhs.moves)
+	{
+		++(*moves);
+	}
+	move_counter& operator=(const move_counter& rhs)
+	{
+		copies = rhs.copies;
+		moves = rhs.moves;
+		++(*copies);
+		return *this;
+	}
+	move_counter& operator=(move_counter&& rhs)
+	{
+		copies = rhs.copies;
+		moves = rhs.moves;
+		++(*moves);
+		return *this;
+	}
+
+	std::shared_ptr<int> copies = std::make_shared<int>(0);
+	std::shared_ptr<int> moves = std::make_shared<int>(0);
+};
+
+template <typename T>
+void test_binder_moves(const std::string& test)
+{
+	TEST_CASE(test + " arguments moved into the last reader")
+	{
+		T binder;
+		// the signatures do not match, so the arguments go through an archive
+		binder.bind("consume", [](move_counter c, long i) { return *c.moves + i; });
+		move_counter counter;
+		EXPECT(binder.template call<long>("consume", std::move(counter), 0) == 1);
+		EXPECT(*counter.copies == 0);
+		EXPECT(*counter.moves == 1);
+
+		// lvalues are not the caller's to give away
+		move_counter kept;
+		binder.template call<long>("consume", kept, 0);
+		EXPECT(*kept.copies == 1);
+
+		// only the last slot may take over the arguments
+		int received = 0;
+		binder.connect("on_value", [&received](move_counter, long) { ++received; });
+		binder.connect("on_value", [&received](move_counter, long) { ++received; });
+		move_counter dispatched;
+		binder.dispatch("on_value", std::move(dispatched), 1);
+		EXPECT(received == 2);
+		// a copy for the first slot, the argument itself for the last one
+		EXPECT(*dispatched.copies == 1);
+
+		// results are moved out of the result archive
+		move_counter result;
+		binder.bind("produce", [&result]() { return result; });
+		binder.template call<move_counter>("produce");
+		EXPECT(*result.copies == 1);
+	};
+}
+
+template <typename T, typename Object>
+void test_move_only(const std::string& test)
+{
+	using buffer_t = std::unique_ptr<std::vector<int>>;
+
+	TEST_CASE(test + " move-only arguments and results")
+	{
+		T binder;
+		// the signatures do not match, so the arguments go through an archive
+		binder.bind("make", [](long size) { return std::make_unique<std::vector<int>>(std::size_t(size)); });
+		binder.bind("size", [](buffer_t buffer, long) { return buffer->size(); });
+
+		auto buffer = binder.template call<buffer_t>("make", 3);
+		EXPECT(buffer != nullptr && buffer->size() == 3);
+		EXPECT(binder.template call<std::size_t>("size", std::move(buffer), 0) == 3);
+
+		// an lvalue would have to be copied
+		auto kept = binder.template call<buffer_t>("make", 1);
+		EXPECT_THROWS(binder.template call<std::size_t>("size", kept, 0));
+		EXPECT(kept != nullptr);
+
+		std::vector<std::function<void()>> tasks;
+		auto deferred = [&tasks](std::function<void()> task) { tasks.emplace_back(std::move(task)); };
+		auto size = binder.template call_async<std::size_t>(deferred, "size", std::move(kept), 0);
+		EXPECT(tasks.size() == 1);
+		tasks.front()();
+		EXPECT(size.get() == 1);
+	};
+
+	TEST_CASE(test + " move-only object fields")
+	{
+		Object obj;
+		obj.set("buffer", std::make_unique<std::vector<int>>(2));
+		EXPECT(obj.has("buffer"));
+
+		std::unique_ptr<int> wrong;
+		EXPECT(!obj.take("buffer", wrong));
+		EXPECT(obj.has("buffer"));
+
+		buffer_t buffer;
+		EXPECT(obj.take("buffer", buffer));
+		EXPECT(buffer != nullptr && buffer->size() == 2);
+		EXPECT(!obj.has("buffer"));
+		EXPECT(!obj.take("buffer", buffer));
+
+		obj.set("buffer", std::move(buffer));
+		EXPECT_THROWS(Object{obj});
+	};
+}
+
+template <typename T>
+void test_binder_priority(const std::string& test, int bursts, int burst_size)
+{
+	TEST_CASE(test + " priority order")
+	{
+		T binder;
+		std::vector<int> order;
+		for(int j = 0; j < 4; ++j)
+		{
+			binder.connect("on_event", [&order, j]() { order.emplace_back(j); }, 1);
+			binder.connect("on_event", [&order, j]() { order.emplace_back(10 + j); }, 2);
+			binder.connect("on_event", [&order, j]() { order.emplace_back(20 + j); }, 0);
+			// flush in between to merge into the already ordered slots
+			binder.dispatch("on_event");
+			order.clear();
+		}
+		binder.dispatch("on_event");
+
+		const std::vector<int> expected{10, 11, 12, 13, 0, 1, 2, 3, 20, 21, 22, 23};
+		EXPECT(order == expected);
+	};
+
+	TEST_CASE(test + " dispatch after connect bursts, bursts=" + std::to_string(bursts) +
+			  ", burst_size=" + std::to_string(burst_size))
+	{
+		T binder;
+		int calls = 0;
+		auto code = [&]() {
+			for(int i = 0; i < bursts; ++i)
+			{
+				for(int j = 0; j < burst_size; ++j)
+				{
+					auto priority = std::uint32_t((i * 7 + j * 13) % 5);
+					binder.connect("on_event", [&calls]() { calls++; }, priority);
+				}
+				binder.dispatch("on_event");
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+		EXPECT(calls == burst_size * bursts * (bursts + 1) / 2);
+	};
+}
+
+template <typename T>
+void test_binder_disconnect(const std::string& test, int calls, int slots)
+{
+	TEST_CASE(test + " disconnect semantics")
+	{
+		T binder;
+		int count = 0;
+		auto first = binder.connect("on_event", [&count]() { count++; });
+		binder.disconnect("on_event", first);
+		// stale ids do nothing, even when the slot entry gets reused
+		binder.disconnect("on_event", first);
+		auto second = binder.connect("on_event", [&count]() { count++; });
+		binder.disconnect("on_event", first);
+		EXPECT(first != second);
+		binder.dispatch("on_event");
+		EXPECT(count == 1);
+
+		// wrong signal
+		binder.disconnect("on_other_event", second);
+		binder.dispatch("on_event");
+		EXPECT(count == 2);
+
+		// disconnecting itself and a later slot while dispatching
+		dyno::slot_t self{};
+		dyno::slot_t later{};
+		self = binder.connect("on_event", [&]() {
+			binder.disconnect("on_event", self);
+			binder.disconnect("on_event", later);
+		});
+		later = binder.connect("on_event", [&count]() { count += 100; });
+		binder.dispatch("on_event");
+		EXPECT(count == 3);
+		binder.dispatch("on_event");
+		EXPECT(count == 4);
+
+		// disconnecting a slot which is still pending
+		auto pending = binder.connect("on_event", [&count]() { count += 100; });
+		binder.disconnect("on_event", pending);
+		binder.dispatch("on_event");
+		EXPECT(count == 5);
+	};
+
+	TEST_CASE(test + " disconnect after a throwing slot")
+	{
+		T binder;
+		auto state = std::make_shared<int>(0);
+		std::weak_ptr<int> observer = state;
+		auto kept = binder.connect("on_event", [state]() { ++(*state); });
+		auto failing = binder.connect("on_event", []() { throw std::runtime_error("failed"); });
+		state.reset();
+
+		EXPECT_THROWS(binder.dispatch("on_event"));
+
+		// the dispatch is over, so the slot is released right away
+		binder.disconnect("on_event", kept);
+		EXPECT(observer.expired());
+		binder.disconnect("on_event", failing);
+		EXPECT_NOTHROWS(binder.dispatch("on_event"));
+	};
+
+	TEST_CASE(test + " connect/disconnect churn, calls=" + std::to_string(calls) +
+			  ", slots=" + std::to_string(slots))
+	{
+		T binder;
+		int count = 0;
+		std::vector<dyno::slot_t> ids;
+		auto code = [&]() {
+			for(int i = 0; i < calls; ++i)
+			{
+				for(int j = 0; j < slots; ++j)
+				{
+					ids.emplace_back(binder.connect("on_event", [&count]() { count++; }));
+				}
+				binder.dispatch("on_event");
+
+				// disconnect every other slot, in reverse
+				for(std::size_t k = 0; k < ids.size(); k += 2)
+				{
+					binder.disconnect("on_event", ids[ids.size() - 1 - k]);
+				}
+				binder.dispatch("on_event");
+				for(auto id : ids)
+				{
+					binder.disconnect("on_event", id);
+				}
+				ids.clear();
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+		EXPECT(count == calls * (slots + slots / 2));
+	};
+}
+
+template <typename T>
+void test_binder_queue(const std::string& test, int calls, int slots)
+{
+	TEST_CASE(test + " queue order")
+	{
+		T binder;
+		std::vector<int> order;
+		binder.connect("on_a", [&order](int i) { order.emplace_back(i); });
+		binder.connect("on_b", [&order](int i) { order.emplace_back(100 + i); });
+		binder.connect("on_a", [&binder, &order](int i) {
+			// queued while processing, so it waits for the next call
+			if(i == 0)
+			{
+				binder.enqueue("on_b", 9);
+			}
+		});
+
+		binder.enqueue("on_a", 0);
+		binder.enqueue("on_b", 0);
+		binder.enqueue("on_a", 1);
+		binder.enqueue("on_unknown", 0);
+		binder.enqueue("on_b", 1);
+
+		EXPECT(binder.process_queue() == 5);
+		const std::vector<int> expected{0, 1, 100, 101};
+		EXPECT(order == expected);
+
+		EXPECT(binder.process_queue() == 1);
+		EXPECT(order.back() == 109);
+		EXPECT(binder.process_queue() == 0);
+	};
+
+	TEST_CASE(test + " queue slots connected during a batch")
+	{
+		T binder;
+		int late = 0;
+		binder.connect("on_a", [&binder, &late](int i) {
+			if(i == 0)
+			{
+				binder.connect("on_a", [&late](int) { late++; });
+			}
+		});
+
+		binder.enqueue("on_a", 0);
+		binder.enqueue("on_a", 1);
+		binder.enqueue("on_a", 2);
+		EXPECT(binder.process_queue() == 3);
+		EXPECT(late == 0);
+
+		binder.enqueue("on_a", 3);
+		EXPECT(binder.process_queue() == 1);
+		EXPECT(late == 1);
+	};
+
+	TEST_CASE(test + " queue keeps unprocessed events on throw")
+	{
+		T binder;
+		int count = 0;
+		binder.connect("on_a", [](int i) {
+			if(i == 1)
+			{
+				throw std::runtime_error("boom");
+			}
+		});
+		binder.connect("on_b", [&count]() { count++; });
+
+		binder.enqueue("on_a", 0);
+		binder.enqueue("on_b");
+		binder.enqueue("on_a", 1);
+		binder.enqueue("on_b");
+
+		EXPECT_THROWS(binder.process_queue());
+		EXPECT(count == 0);
+		EXPECT(binder.process_queue() == 2);
+		EXPECT(count == 2);
+	};
+
+	TEST_CASE(test + " queue with many distinct signals, keys=" + std::to_string(calls * slots))
+	{
+		T binder;
+		const int keys = calls * slots;
+		std::vector<int> received(std::size_t(keys), 0);
+		for(int key = 0; key < keys; key += 2)
+		{
+			binder.connect("on_key_" + std::to_string(key), [&received, key](int round) {
+				// a signal gets its events in the order they were queued
+				EXPECT(received[std::size_t(key)] == round);
+				received[std::size_t(key)]++;
+			});
+		}
+
+		for(int round = 0; round < 2; ++round)
+		{
+			for(int key = 0; key < keys; ++key)
+			{
+				binder.enqueue("on_key_" + std::to_string(key), round);
+			}
+		}
+
+		EXPECT(binder.process_queue() == std::size_t(keys * 2));
+		for(int key = 0; key < keys; ++key)
+		{
+			EXPECT(received[std::size_t(key)] == (key % 2 == 0 ? 2 : 0));
+		}
+	};
+
+	T binder;
+	int dispatched = 0;
+	for(int j = 0; j < slots; ++j)
+	{
+		binder.connect("plugin_on_system_ready", [&dispatched](int i) { dispatched += i; });
+	}
+
+	TEST_CASE(test + " queued dispatch, calls=" + std::to_string(calls) + ", slots=" + std::to_string(slots))
+	{
+		auto code = [&]() {
+			for(int i = 0; i < calls; ++i)
+			{
+				binder.enqueue("plugin_on_system_ready", 1);
+			}
+			binder.process_queue();
+		};
+
+		EXPECT_NOTHROWS(code());
+		EXPECT(dispatched == calls * slots);
+	};
+}
+
+template <typename T>
+void test_binder_dispatch_many(const std::string& test, int calls, int slots)
+{
+	TEST_CASE(test + " dispatch_many order")
+	{
+		T binder;
+		std::vector<int> order;
+		binder.connect("on_sample", [&order](int i) { order.emplace_back(i); });
+		binder.connect("on_sample", [&order](const int& i) { order.emplace_back(10 + i); });
+		// not matching the event types, so it goes through the archive
+		binder.connect("on_sample", [&order](long i) { order.emplace_back(20 + int(i)); });
+
+		const std::vector<std::tuple<int>> samples{std::make_tuple(0), std::make_tuple(1)};
+
+		binder.dispatch_many("on_sample", samples);
+		const std::vector<int> event_major{0, 10, 20, 1, 11, 21};
+		EXPECT(order == event_major);
+
+		order.clear();
+		binder.dispatch_many("on_sample", samples, dyno::dispatch_order::slot_major);
+		const std::vector<int> slot_major{0, 1, 10, 11, 20, 21};
+		EXPECT(order == slot_major);
+	};
+
+	TEST_CASE(test + " dispatch_many disconnect midway")
+	{
+		T binder;
+		int count = 0;
+		dyno::slot_t self{};
+		self = binder.connect("on_sample", [&](int i) {
+			count += i;
+			binder.disconnect("on_sample", self);
+		});
+
+		const std::vector<std::tuple<int>> samples{std::make_tuple(1), std::make_tuple(2)};
+		binder.dispatch_many("on_sample", samples);
+		EXPECT(count == 1);
+		binder.dispatch_many("on_sample", samples);
+		EXPECT(count == 1);
+	};
+
+	TEST_CASE(test + " dispatch_many disconnect after a throwing slot")
+	{
+		T binder;
+		auto state = std::make_shared<int>(0);
+		std::weak_ptr<int> observer = state;
+		auto kept = binder.connect("on_sample", [state](long) { ++(*state); });
+		binder.connect("on_sample", [](int) { throw std::runtime_error("failed"); });
+		state.reset();
+
+		const std::vector<std::tuple<int>> samples(3, std::make_tuple(1));
+		EXPECT_THROWS(binder.dispatch_many("on_sample", samples));
+
+		// the dispatch is over, so the slot is released right away
+		binder.disconnect("on_sample", kept);
+		EXPECT(observer.expired());
+	};
+
+	T binder;
+	auto signal = binder.resolve("on_sample");
+	int dispatched = 0;
+	for(int j = 0; j < slots; ++j)
+	{
+		binder.connect("on_sample", [&dispatched](int i, float) { dispatched += i; });
+	}
+	const std::vector<std::tuple<int, float>> samples(std::size_t(calls), std::make_tuple(1, 0.5f));
+
+	TEST_CASE(test + " dispatch loop, calls=" + std::to_string(calls) + ", slots=" + std::to_string(slots))
+	{
+		dispatched = 0;
+		auto code = [&]() {
+			for(const auto& sample : samples)
+			{
+				binder.dispatch("on_sample", std::get<0>(sample), std::get<1>(sample));
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+		EXPECT(dispatched == calls * slots);
+	};
+
+	for(auto order : {dyno::dispatch_order::event_major, dyno::dispatch_order::slot_major})
+	{
+		const std::string name = order == dyno::dispatch_order::event_major ? "event_major" : "slot_major";
+		TEST_CASE(test + " dispatch_many " + name + ", calls=" + std::to_string(calls) +
+				  ", slots=" + std::to_string(slots))
+		{
+			dispatched = 0;
+			EXPECT_NOTHROWS(binder.dispatch_many(signal, samples, order));
+			EXPECT(dispatched == calls * slots);
+		};
+	}
+}
+
+template <typename T>
+void test_binder_wildcards(const std::string& test, int calls, int slots)
+{
+	TEST_CASE(test + " wildcard matching")
+	{
+		T binder;
+		std::vector<std::string> order;
+		binder.connect("net.peer.joined", [&order](int) { order.emplace_back("exact"); });
+		binder.connect("net.**", [&order](int) { order.emplace_back("net.**"); });
+		binder.connect("net.*.joined", [&order](int) { order.emplace_back("net.*.joined"); });
+		binder.connect("net.peer.*", [&order](int) { order.emplace_back("net.peer.*"); });
+
+		binder.dispatch("net.peer.joined", 1);
+		const std::vector<std::string> expected{"exact", "net.peer.*", "net.*.joined", "net.**"};
+		EXPECT(order == expected);
+
+		order.clear();
+		binder.dispatch("net.peer", 1);
+		binder.dispatch("net", 1);
+		binder.dispatch("network.peer.joined", 1);
+		EXPECT(order == std::vector<std::string>{"net.**"});
+
+		order.clear();
+		binder.dispatch("net.host.joined.late", 1);
+		EXPECT(order == std::vector<std::string>{"net.**"});
+	};
+
+	TEST_CASE(test + " wildcard cache invalidation")
+	{
+		T binder;
+		int exact = 0;
+		int any = 0;
+		binder.connect("ui.button.click", [&exact]() { exact++; });
+		binder.dispatch("ui.button.click");
+		binder.dispatch("ui.menu.click");
+
+		// connected after both keys cached their (empty) matches
+		auto id = binder.connect("ui.*.click", [&any]() { any++; });
+		binder.dispatch("ui.button.click");
+		binder.dispatch("ui.menu.click");
+		EXPECT(exact == 2);
+		EXPECT(any == 2);
+
+		binder.disconnect("ui.*.click", id);
+		binder.dispatch("ui.button.click");
+		binder.dispatch("ui.menu.click");
+		EXPECT(exact == 3);
+		EXPECT(any == 2);
+	};
+
+	TEST_CASE(test + " wildcard handles and queue")
+	{
+		T binder;
+		int sum = 0;
+		auto handle = binder.resolve("game.player.spawn");
+		binder.connect("game.**", [&sum](int i) { sum += i; });
+		binder.dispatch(handle, 1);
+
+		binder.enqueue("game.enemy.spawn", 10);
+		binder.enqueue("audio.play", 100);
+		EXPECT(binder.process_queue() == 2);
+		EXPECT(sum == 11);
+	};
+
+	TEST_CASE(test + " wildcard dispatch_many and dispatch_parallel")
+	{
+		T binder;
+		std::atomic<int> exact{0};
+		std::atomic<int> any{0};
+		binder.connect("net.peer.joined", [&exact](int i) { exact += i; });
+		binder.connect("net.**", [&any](int i) { any += i; });
+
+		// same as dispatch, whatever entry point the producer uses
+		const std::vector<std::tuple<int>> samples{std::make_tuple(1), std::make_tuple(2)};
+		binder.dispatch_many("net.peer.joined", samples);
+		binder.dispatch_many("net.peer.left", samples);
+		binder.dispatch_many(binder.resolve("net.host.up"), samples);
+		EXPECT(exact == 3);
+		EXPECT(any == 9);
+
+		dyno::thread_pool pool(2);
+		binder.dispatch_parallel(pool, "net.peer.joined", 10);
+		binder.dispatch_parallel(pool, "net.peer.left", 100);
+		EXPECT(exact == 13);
+		EXPECT(any == 119);
+	};
+
+	TEST_CASE(test + " wildcard slots connected during a batch")
+	{
+		T binder;
+		int late = 0;
+		binder.connect("game.*", [&binder, &late](int i) {
+			if(i == 0)
+			{
+				binder.connect("game.**", [&late](int) { late++; });
+				binder.connect("game.*", [&late](int) { late++; });
+			}
+		});
+
+		binder.enqueue("game.tick", 0);
+		binder.enqueue("game.tick", 1);
+		binder.enqueue("game.tick", 2);
+		EXPECT(binder.process_queue() == 3);
+		EXPECT(late == 0);
+
+		binder.enqueue("game.tick", 3);
+		EXPECT(binder.process_queue() == 1);
+		EXPECT(late == 2);
+	};
+
+	TEST_CASE(test + " wildcard disconnect while dispatching")
+	{
+		T binder;
+		int count = 0;
+		dyno::slot_t id = 0;
+		binder.connect("a.*", [&]() {
+			count++;
+			binder.disconnect("a.**", id);
+		});
+		id = binder.connect("a.**", [&count]() { count++; });
+
+		binder.dispatch("a.b");
+		binder.dispatch("a.b");
+		EXPECT(count == 2);
+	};
+
+	T binder;
+	int dispatched = 0;
+	for(int j = 0; j < slots; ++j)
+	{
+		binder.connect("plugin.system.ready", [&dispatched](int i) { dispatched += i; });
+	}
+	// patterns which do not match the benchmarked key
+	binder.connect("plugin.*.loaded", [](int) {});
+	binder.connect("editor.**", [](int) {});
+
+	TEST_CASE(test + " exact dispatch next to wildcards, calls=" + std::to_string(calls) +
+			  ", slots=" + std::to_string(slots))
+	{
+		auto code = [&]() {
+			for(int i = 0; i < calls; ++i)
+			{
+				binder.dispatch("plugin.system.ready", 1);
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+		EXPECT(dispatched == calls * slots);
+	};
+
+	TEST_CASE(test + " wildcard dispatch, calls=" + std::to_string(calls) +
+			  ", slots=" + std::to_string(slots))
+	{
+		dispatched = 0;
+		for(int j = 0; j < slots; ++j)
+		{
+			binder.connect("plugin.**", [&dispatched](int i) { dispatched += i; });
+		}
+
+		auto code = [&]() {
+			for(int i = 0; i < calls; ++i)
+			{
+				binder.dispatch("plugin.system.ready", 1);
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+		EXPECT(dispatched == calls * slots * 2);
+	};
+}
+
+// entries currently held by all counted_tables
+std::size_t counted_entries = 0;
+
+template <typename Key, typename T>
+struct counted_table : std::map<Key, T, std::less<>>
+{
+	using base = std::map<Key, T, std::less<>>;
+	using typename base::iterator;
+
+	counted_table() = default;
+	counted_table(const counted_table&) = delete;
+	counted_table& operator=(const counted_table&) = delete;
+	~counted_table()
+	{
+		counted_entries -= this->size();
+	}
+
+	template <typename... Args>
+	std::pair<iterator, bool> emplace(Args&&... args)
+	{
+		auto result = base::emplace(std::forward<Args>(args)...);
+		counted_entries += result.second ? 1 : 0;
+		return result;
+	}
+
+	iterator erase(iterator it)
+	{
+		--counted_entries;
+		return base::erase(it);
+	}
+};
+
+struct counted_binder_traits : dyno::binder_traits
+{
+	template <typename Key, typename T>
+	using table_t = counted_table<Key, T>;
+
+	constexpr static std::size_t wildcard_cache_size = 16;
+};
+
+void test_binder_wildcard_cache(const std::string& test, int keys)
+{
+	using binder_t = dyno::binder<dyno::anystream, dyno::anystream, std::string, std::string,
+								  std::weak_ptr<void>, counted_binder_traits>;
+
+	TEST_CASE(test + " entries cached for a pattern are released with it, keys=" + std::to_string(keys))
+	{
+		binder_t binder;
+		int dispatched = 0;
+		auto id = binder.connect("net.peer.*", [&dispatched](int) { dispatched++; });
+		for(int i = 0; i < keys; ++i)
+		{
+			binder.dispatch("net.peer." + std::to_string(i), i);
+		}
+		EXPECT(dispatched == keys);
+		// the pattern, its cached keys and no more than the cache size
+		EXPECT(counted_entries <= 1 + counted_binder_traits::wildcard_cache_size);
+
+		binder.disconnect("net.peer.*", id);
+		EXPECT(counted_entries == 0);
+
+		// dispatching with no pattern left does not add entries
+		for(int i = 0; i < keys; ++i)
+		{
+			binder.dispatch("net.peer." + std::to_string(i), i);
+		}
+		EXPECT(counted_entries == 0);
+		EXPECT(dispatched == keys);
+	};
+
+	TEST_CASE(test + " entries with slots are not evicted, keys=" + std::to_string(keys))
+	{
+		binder_t binder;
+		int dispatched = 0;
+		binder.connect("net.peer.joined", [&dispatched](int) { dispatched++; });
+		auto id = binder.connect("net.peer.*", [&dispatched](int) { dispatched++; });
+		for(int i = 0; i < keys; ++i)
+		{
+			binder.dispatch("net.peer." + std::to_string(i), i);
+			binder.dispatch("net.peer.joined", i);
+		}
+		EXPECT(dispatched == keys * 3);
+		EXPECT(counted_entries <= 2 + counted_binder_traits::wildcard_cache_size);
+
+		binder.disconnect("net.peer.*", id);
+		EXPECT(counted_entries == 1);
+		binder.dispatch("net.peer.joined", 0);
+		EXPECT(dispatched == keys * 3 + 1);
+	};
+	EXPECT(counted_entries == 0);
+}
+
+template <typename T>
+void test_concurrent_binder(const std::string& test)
+{
+	TEST_CASE(test + " api")
+	{
+		T binder;
+		std::vector<int> order;
+		auto signal = binder.resolve("on_event");
+		auto first = binder.connect("on_event", [&order]() { order.emplace_back(0); });
+		binder.connect("on_event", [&order]() { order.emplace_back(1); }, 1);
+		binder.connect("on_event", [&order]() { order.emplace_back(2); });
+		binder.dispatch(signal);
+		const std::vector<int> expected{1, 0, 2};
+		EXPECT(order == expected);
+
+		binder.disconnect("on_event", first);
+		binder.disconnect("on_event", first);
+		order.clear();
+		binder.dispatch("on_event");
+		const std::vector<int> expected_disconnected{1, 2};
+		EXPECT(order == expected_disconnected);
+
+		auto unicast = binder.resolve_call("call");
+		EXPECT(!binder.is_bound("call"));
+		binder.bind("call", [](int a, const std::string& b) { return a + int(b.size()); });
+		EXPECT(binder.is_bound("call"));
+		EXPECT(binder.template call<int>("call", 1, std::string("ab")) == 3);
+		EXPECT(binder.template call<int>(unicast, 2, std::string("ab")) == 4);
+		const std::string borrowed("abc");
+		EXPECT(binder.template call<int>(unicast, 2.0, borrowed) == 5);
+
+		auto sentinel = std::make_shared<int>();
+		binder.bind("call", sentinel, [](int a) { return a; });
+		EXPECT(binder.template call<int>(unicast, 5) == 5);
+		sentinel.reset();
+		EXPECT_THROWS(binder.template call<int>(unicast, 5));
+
+		binder.unbind("call");
+		EXPECT(!binder.is_bound("call"));
+		EXPECT_THROWS(binder.call("call", 1));
+
+		binder.clear();
+		order.clear();
+		binder.dispatch(signal);
+		EXPECT(order.empty());
+	};
+
+	TEST_CASE(test + " dispatch while connecting and disconnecting")
+	{
+		T binder;
+		constexpr int stable_slots = 4;
+		for(int j = 0; j < stable_slots; ++j)
+		{
+			binder.connect("on_event", [](int* count) { ++*count; });
+		}
+
+		std::atomic<bool> done{false};
+		std::atomic<int> dispatches{0};
+		std::atomic<int> stable_calls{0};
+		std::vector<std::thread> readers;
+		for(int t = 0; t < 4; ++t)
+		{
+			readers.emplace_back([&]() {
+				while(!done)
+				{
+					int count = 0;
+					binder.dispatch("on_event", &count);
+					stable_calls += count;
+					++dispatches;
+				}
+			});
+		}
+
+		// the churned slots do not count
+		for(int i = 0; i < 1000; ++i)
+		{
+			auto id = binder.connect("on_event", [](int*) {});
+			binder.bind("call", [i]() { return i; });
+			binder.disconnect("on_event", id);
+		}
+		done = true;
+		for(auto& reader : readers)
+		{
+			reader.join();
+		}
+
+		EXPECT(stable_calls == dispatches * stable_slots);
+		EXPECT(binder.template call<int>("call") == 999);
+	};
+}
+
+template <typename T>
+void test_binder_contention(const std::string& test, int calls, int slots, std::mutex* mutex)
+{
+	T binder;
+	auto signal = binder.resolve("on_event");
+	for(int j = 0; j < slots; ++j)
+	{
+		binder.connect("on_event", [](int* count) { ++*count; });
+	}
+
+	const auto max_threads = std::max(2, int(std::thread::hardware_concurrency()));
+	for(int threads = 1;; threads = std::min(threads * 2, max_threads))
+	{
+		TEST_CASE(test + " contention, threads=" + std::to_string(threads) + ", calls=" +
+				  std::to_string(calls) + ", slots=" + std::to_string(slots))
+		{
+			std::atomic<int> total{0};
+			std::vector<std::thread> workers;
+			for(int t = 0; t < threads; ++t)
+			{
+				workers.emplace_back([&]() {
+					int count = 0;
+					for(int i = 0; i < calls; ++i)
+					{
+						if(mutex)
+						{
+							std::lock_guard<std::mutex> lock(*mutex);
+							binder.dispatch(signal, &count);
+						}
+						else
+						{
+							binder.dispatch(signal, &count);
+						}
+					}
+					total += count;
+				});
+			}
+			for(auto& worker : workers)
+			{
+				worker.join();
+			}
+
+			EXPECT(total == threads * calls * slots);
+		};
+
+		if(threads == max_threads)
+		{
+			break;
+		}
+	}
+}
+
+template <typename T>
+void test_event_inbox(const std::string& test, int calls, int producers)
+{
+	TEST_CASE(test + " backpressure")
+	{
+		T binder;
+		std::vector<int> received;
+		binder.connect("on_event", [&received](int i) { received.emplace_back(i); });
+
+		using inbox_t = dyno::event_inbox<T>;
+		inbox_t drop_newest(binder, 4, dyno::backpressure::drop_newest);
+		inbox_t drop_oldest(binder, 4, dyno::backpressure::drop_oldest);
+		for(int i = 0; i < 6; ++i)
+		{
+			EXPECT(drop_newest.post("on_event", i) == (i < 4));
+			EXPECT(drop_oldest.post("on_event", i));
+		}
+		EXPECT(drop_newest.depth() == 4);
+		EXPECT(drop_newest.dropped() == 2);
+		EXPECT(drop_oldest.dropped() == 2);
+
+		EXPECT(drop_newest.drain(1) == 1);
+		EXPECT(drop_newest.drain() == 3);
+		EXPECT(drop_newest.depth() == 0);
+		EXPECT(drop_oldest.drain() == 4);
+
+		const std::vector<int> expected{0, 1, 2, 3, 2, 3, 4, 5};
+		EXPECT(received == expected);
+	};
+
+	TEST_CASE(test + " post from producers, calls=" + std::to_string(calls) +
+			  ", producers=" + std::to_string(producers))
+	{
+		T binder;
+		int sum = 0;
+		binder.connect("on_event", [&sum](int i) { sum += i; });
+
+		dyno::event_inbox<T> inbox(binder, 1024, dyno::backpressure::block);
+		std::atomic<int> done{0};
+		std::vector<std::thread> threads;
+		for(int t = 0; t < producers; ++t)
+		{
+			threads.emplace_back([&]() {
+				for(int i = 0; i < calls; ++i)
+				{
+					inbox.post("on_event", 1);
+				}
+				++done;
+			});
+		}
+
+		std::size_t drained = 0;
+		while(done < producers || inbox.depth() > 0)
+		{
+			drained += inbox.drain(256);
+		}
+		for(auto& thread : threads)
+		{
+			thread.join();
+		}
+		drained += inbox.drain();
+
+		EXPECT(drained == std::size_t(calls * producers));
+		EXPECT(sum == calls * producers);
+		EXPECT(inbox.dropped() == 0);
+	};
+}
+
+template <typename T>
+void test_binder_parallel(const std::string& test, int calls, int slots)
+{
+	dyno::thread_pool pool(4);
+
+	TEST_CASE(test + " parallel priority bands")
+	{
+		T binder;
+		std::atomic<int> high{0};
+		std::atomic<int> low{0};
+		std::atomic<bool> ordered{true};
+		for(int j = 0; j < slots; ++j)
+		{
+			binder.connect("on_event", [&](int a) { high += a; }, 2);
+			// not matching the dispatched types, so it reads the shared archive
+			binder.connect("on_event", [&](long a) {
+				ordered = ordered && high == 2 * slots;
+				low += int(a);
+			}, 1);
+		}
+
+		binder.dispatch_parallel(pool, "on_event", 2);
+		EXPECT(high == 2 * slots);
+		EXPECT(low == 2 * slots);
+		EXPECT(ordered);
+
+		auto state = std::make_shared<int>(0);
+		std::weak_ptr<int> observer = state;
+		auto kept = binder.connect("on_event", [state](int) { ++(*state); });
+		binder.connect("on_event", [](int) { throw std::runtime_error("failed"); });
+		state.reset();
+		EXPECT_THROWS(binder.dispatch_parallel(pool, "on_event", 2));
+
+		// the dispatch is over, so the slot is released right away
+		binder.disconnect("on_event", kept);
+		EXPECT(observer.expired());
+	};
+
+	T binder;
+	std::atomic<int> dispatched{0};
+	for(int j = 0; j < slots; ++j)
+	{
+		binder.connect("on_heavy_event", [&dispatched](int iterations) {
+			volatile int sink = 0;
+			for(int i = 0; i < iterations; ++i)
+			{
+				sink = sink + i;
+			}
+			++dispatched;
+		});
+	}
+
+	TEST_CASE(test + " sequential heavy slots, calls=" + std::to_string(calls) +
+			  ", slots=" + std::to_string(slots))
+	{
+		dispatched = 0;
+		auto code = [&]() {
+			for(int i = 0; i < calls; ++i)
+			{
+				binder.dispatch("on_heavy_event", 10000);
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+		EXPECT(dispatched == calls * slots);
+	};
+
+	TEST_CASE(test + " parallel heavy slots, calls=" + std::to_string(calls) +
+			  ", slots=" + std::to_string(slots) + ", threads=" + std::to_string(pool.size()))
+	{
+		dispatched = 0;
+		auto code = [&]() {
+			for(int i = 0; i < calls; ++i)
+			{
+				binder.dispatch_parallel(pool, "on_heavy_event", 10000);
+			}
+		};
+
+		EXPECT_NOTHROWS(code());
+		EXPECT(dispatched == calls * slots);
+	};
+}
+
+template <typename T>
+void test_binder_async(const std::string& test, int calls)
+{
+	TEST_CASE(test + " call_async")
+	{
+		T binder;
+		binder.bind("add", [](int a, int b) { return a + b; });
+		auto handle = binder.resolve_call("add");
+
+		// runs the tasks only when asked to
+		std::vector<std::function<void()>> tasks;
+		auto deferred = [&tasks](std::function<void()> task) { tasks.emplace_back(std::move(task)); };
+
+		auto sum = binder.template call_async<int>(deferred, "add", 1, 2);
+		auto sum_handle = binder.template call_async<int>(deferred, handle, 3, 4);
+		// does not affect the calls already made
+		binder.unbind("add");
+		EXPECT_THROWS(binder.template call_async<int>(deferred, "add", 1, 2));
+
+		std::string message;
+		try
+		{
+			binder.template call_async<int>(deferred, handle, 1, 2);
+		}
+		catch(const std::exception& e)
+		{
+			message = e.what();
+		}
+		EXPECT(message.find("expecting a return value") != std::string::npos);
+
+		auto sentinel = std::make_shared<int>();
+		int called = 0;
+		binder.bind("notify", sentinel, [&called]() { called++; });
+		auto notified = binder.call_async(deferred, "notify");
+		auto expired = binder.call_async(deferred, "notify");
+
+		EXPECT(tasks.size() == 4);
+		for(std::size_t i = 0; i < 3; ++i)
+		{
+			tasks[i]();
+		}
+		sentinel.reset();
+		tasks[3]();
+
+		EXPECT(sum.get() == 3);
+		EXPECT(sum_handle.get() == 7);
+		EXPECT_NOTHROWS(notified.get());
+		EXPECT(called == 1);
+		EXPECT_THROWS(expired.get());
+	};
+
+	dyno::thread_pool pool(4);
+	T binder;
+	binder.bind("heavy", [](int iterations) {
+		int sum = 0;
+		for(int i = 0; i < iterations; ++i)
+		{
+			sum = (sum + i) % 1000;
+		}
+		return sum;
+	});
+
+	TEST_CASE(test + " call_async on a thread pool, calls=" + std::to_string(calls))
+	{
+		std::vector<std::future<int>> results;
+		for(int i = 0; i < calls; ++i)
+		{
+			results.emplace_back(binder.template call_async<int>(pool, "heavy", 100000));
+		}
+
+		const auto expected = binder.template call<int>("heavy", 100000);
+		for(auto& result : results)
+		{
+			EXPECT(result.get() == expected);
+		}
+	};
+}
+
+struct std_function_binder_traits : dyno::binder_traits
+{
+	template <typename Signature>
+	using delegate_t = std::function<Signature>;
+};
+
+void test_delegate(const std::string& test)
+{
+	TEST_CASE(test)
+	{
+		using delegate = dyno::inplace_delegate<int(int), 16>;
+
+		int small_state = 1;
+		delegate small = [small_state](int a) { return a + small_state; };
+		EXPECT(small(1) == 2);
+
+		// does not fit inplace and goes on the heap
+		std::array<int, 16> big_state{};
+		big_state[15] = 2;
+		delegate big = [big_state](int a) { return a + big_state[15]; };
+		EXPECT(big(1) == 3);
+
+		delegate moved = std::move(big);
+		EXPECT(!big);
+		EXPECT(moved(1) == 3);
+
+		moved = std::move(small);
+		EXPECT(moved(1) == 2);
+
+		moved = nullptr;
+		EXPECT(!moved);
+		EXPECT_THROWS(moved(1));
+	};
+}
+
+void test_flat_hash_map(const std::string& test, int keys)
+{
+	TEST_CASE(test + ", keys=" + std::to_string(keys))
+	{
+		dyno::flat_hash_map<std::string, int> map;
+		for(int i = 0; i < keys; ++i)
+		{
+			EXPECT(map.emplace("key" + std::to_string(i), i).second);
+		}
+		EXPECT(map.size() == size_t(keys));
+		EXPECT(!map.emplace("key0", -1).second);
+
+		// erase every other key, leaving tombstones behind
+		for(int i = 0; i < keys; i += 2)
+		{
+			EXPECT(map.erase(std::string("key" + std::to_string(i))) == 1);
+		}
+
+		// transparent lookups with views
+		for(int i = 0; i < keys; ++i)
+		{
+			auto key = "key" + std::to_string(i);
+			auto it = map.find(hpp::string_view(key));
+			EXPECT((it != std::end(map)) == (i % 2 == 1));
+		}
+
+		// reinsert to force reuse of the tombstones
+		for(int i = 0; i < keys; i += 2)
+		{
+			map.emplace("key" + std::to_string(i), i);
+		}
+
+		int sum = 0;
+		for(const auto& kvp : map)
+		{
+			sum += kvp.second;
+		}
+		EXPECT(sum == keys * (keys - 1) / 2);
+	};
+
+	TEST_CASE(test + " integral keys, keys=" + std::to_string(keys))
+	{
+		// multiples of a power of two share the low bits of their identity hash
+		dyno::flat_hash_map<int, int> map;
+		std::set<std::uint8_t> tags;
+		for(int i = 0; i < keys; ++i)
+		{
+			EXPECT(map.emplace(i * 1024, i).second);
+			tags.emplace(std::uint8_t(dyno::transparent_hash{}(i * 1024) >> (sizeof(std::size_t) * 8 - 7)));
+		}
+		EXPECT(map.size() == size_t(keys));
+		EXPECT(tags.size() > 1);
+
+		for(int i = 0; i < keys; ++i)
+		{
+			auto it = map.find(i * 1024);
+			EXPECT(it != std::end(map) && it->second == i);
+		}
+		EXPECT(map.find(1) == std::end(map));
+	};
+}
+
+void test_hashed_key(const std::string& test)
+{
+	using namespace dyno::literals;
+
+	constexpr dyno::hashed_key on_tick("on_tick");
+	static_assert(on_tick == "on_tick"_key, "literal keys are hashed at compile time");
+	static_assert(on_tick.value() == dyno::hashed_key::hash("on_tick", 7), "");
+
+	TEST_CASE(test + " keys")
+	{
+		using binder_t = dyno::binder<dyno::anystream, dyno::anystream, dyno::hashed_key>;
+		binder_t binder;
+		int sum = 0;
+		binder.connect(on_tick, [&sum](int i) { sum += i; });
+		binder.dispatch("on_tick", 1);
+		binder.dispatch("on_tick"_key, 1);
+		binder.dispatch(std::string("on_tick"), 1);
+		binder.dispatch("on_other_tick", 1);
+		EXPECT(sum == 3);
+
+		{
+			// the stored key must not point to this buffer once it is gone
+			std::string name = "on_call";
+			binder.bind(dyno::hashed_key(name.c_str(), name.size()), [](int i) { return i; });
+		}
+		EXPECT(binder.template call<int>("on_call", 4) == 4);
+		binder.bind("on_throw", []() { throw std::runtime_error("boom"); });
+
+		std::string message;
+		try
+		{
+			binder.call("on_throw");
+		}
+		catch(const std::exception& e)
+		{
+			message = e.what();
+		}
+#ifndef NDEBUG
+		EXPECT(message.find("on_throw") != std::string::npos);
+#else
+		// stored keys only keep their hash
+		dyno::hashed_key stored("on_throw");
+		stored.validate();
+		EXPECT(message.find(stored.name()) != std::string::npos);
+#endif
+	};
+}
+
+template <typename To, typename From>
+void test_anystream_conversion(const std::string& test, const From& value, const To& expected, int casts)
+{
+	TEST_CASE(test + ", casts=" + std::to_string(casts))
+	{
+		const hpp::any operand(value);
+		bool converted = true;
+		for(int i = 0; i < casts; ++i)
+		{
+			To result{};
+			converted &= dyno::try_implicit_cast(operand, result) && result == expected;
+		}
+		EXPECT(converted);
+	};
+}
+
+void test_anystream_conversions(const std::string& test, int casts)
+{
+	test_anystream_conversion<int>(test + " exact int", 42, 42, casts);
+	test_anystream_conversion<std::string>(test + " exact string", std::string("on_tick"), "on_tick", casts);
+
+	test_anystream_conversion<int>(test + " int8 -> int", std::int8_t(-42), -42, casts);
+	test_anystream_conversion<std::int64_t>(test + " int -> int64", -42, -42, casts);
+	test_anystream_conversion<std::uint32_t>(test + " uint8 -> uint32", std::uint8_t(42), 42u, casts);
+	test_anystream_conversion<double>(test + " float -> double", 0.5f, 0.5, casts);
+	test_anystream_conversion<int>(test + " char -> int", 'a', int('a'), casts);
+
+	test_anystream_conversion<int>(test + " double -> int", 42.5, 42, casts);
+	test_anystream_conversion<std::int16_t>(test + " int64 -> int16", std::int64_t(-42), std::int16_t(-42),
+											casts);
+	test_anystream_conversion<float>(test + " double -> float", 0.5, 0.5f, casts);
+	test_anystream_conversion<char>(test + " int -> char", int('a'), 'a', casts);
+
+	test_anystream_conversion<std::string>(test + " const char* -> string", "on_tick", "on_tick", casts);
+	test_anystream_conversion<const char*>(test + " nullptr -> const char*", nullptr, nullptr, casts);
+
+	TEST_CASE(test + " cached int -> double, casts=" + std::to_string(casts))
+	{
+		const hpp::any operand(42);
+		dyno::conversion_cache<double> cache;
+		bool converted = true;
+		for(int i = 0; i < casts; ++i)
+		{
+			double result{};
+			converted &= dyno::try_implicit_cast(operand, result, cache) && result == 42.0;
+		}
+		EXPECT(converted);
+	};
+
+	TEST_CASE(test + " cache invalidation")
+	{
+		dyno::conversion_cache<double> cache;
+		double result{};
+		EXPECT(dyno::try_implicit_cast(hpp::any(42), result, cache));
+		EXPECT(result == 42.0);
+		EXPECT(cache.get() != nullptr);
+		EXPECT(cache.get()->first == typeid(int));
+
+		EXPECT(dyno::try_implicit_cast(hpp::any(0.5f), result, cache));
+		EXPECT(result == 0.5);
+		EXPECT(cache.get()->first == typeid(float));
+
+		// exact matches need no conversion
+		EXPECT(dyno::try_implicit_cast(hpp::any(0.25), result, cache));
+		EXPECT(result == 0.25);
+		EXPECT(cache.get() == nullptr);
+
+		EXPECT(!dyno::try_implicit_cast(hpp::any(std::string("42")), result, cache));
+		EXPECT(cache.get() == nullptr);
+	};
+
+	TEST_CASE(test + " unrelated types")
+	{
+		int to_int{};
+		std::string to_string;
+		EXPECT(!dyno::try_implicit_cast(hpp::any(std::string("42")), to_int));
+		EXPECT(!dyno::try_implicit_cast(hpp::any(42), to_string));
+		EXPECT(!dyno::try_implicit_cast(hpp::any(), to_int));
+	};
+}
+
+void test_any(const std::string& test)
+{
+	TEST_CASE(test + " inline and heap values")
+	{
+		using any = dyno::basic_any<sizeof(std::string)>;
+		using big_t = std::array<char, sizeof(std::string) + 1>;
+
+		const auto before = allocation_count();
+		any small(42);
+		any str(std::string("a string long enough to allocate its own buffer"));
+		const auto str_allocations = allocation_count() - before;
+		any big(big_t{{'b'}});
+		const auto big_allocations = allocation_count() - before - str_allocations;
+		// only the buffer of the string and the holder of the big value
+		EXPECT(str_allocations == 1);
+		EXPECT(big_allocations == 1);
+
+		EXPECT(dyno::any_cast<int>(&small) != nullptr);
+		EXPECT(dyno::any_cast<long>(&small) == nullptr);
+		EXPECT(dyno::any_cast<int>(small) == 42);
+		EXPECT(small.type() == typeid(int));
+		EXPECT_THROWS(dyno::any_cast<std::string>(small));
+		EXPECT(dyno::any_cast<big_t>(&big)->front() == 'b');
+
+		auto copy = str;
+		auto moved = std::move(str);
+		EXPECT(!str.has_value());
+		EXPECT(dyno::any_cast<std::string>(copy) == dyno::any_cast<std::string>(moved));
+
+		auto big_copy = big;
+		big = std::move(small);
+		EXPECT(dyno::any_cast<int>(big) == 42);
+		EXPECT(dyno::any_cast<big_t>(big_copy).front() == 'b');
+
+		big_copy.swap(copy);
+		EXPECT(big_copy.type() == typeid(std::string));
+		EXPECT(copy.type() == typeid(big_t));
+
+		copy.reset();
+		EXPECT(!copy.has_value());
+		EXPECT(copy.type() == typeid(void));
+		EXPECT(dyno::any_cast<big_t>(&copy) == nullptr);
+	};
+
+	TEST_CASE(test + " move-only values")
+	{
+		dyno::any value(std::make_unique<int>(42));
+		EXPECT(value.type() == typeid(std::unique_ptr<int>));
+		EXPECT(**dyno::any_cast<std::unique_ptr<int>>(&value) == 42);
+		EXPECT_THROWS(dyno::any{value});
+
+		auto moved = std::move(value);
+		EXPECT(!value.has_value());
+		auto ptr = dyno::any_cast<std::unique_ptr<int>>(std::move(moved));
+		EXPECT(ptr != nullptr && *ptr == 42);
+	};
+}
+
+void test_small_vector(const std::string& test, int elements)
+{
+	TEST_CASE(test + ", elements=" + std::to_string(elements))
+	{
+		dyno::small_vector<std::string, 4> vec;
+		for(int i = 0; i < 4; ++i)
+		{
+			vec.emplace_back(std::to_string(i));
+		}
+		EXPECT(!vec.is_heap());
+		EXPECT(vec.capacity() == 4);
+
+		// referring to an element which moves while growing
+		vec.push_back(vec[0]);
+		EXPECT(vec.is_heap());
+		EXPECT(vec.back() == "0");
+
+		for(int i = 5; i < elements; ++i)
+		{
+			vec.emplace_back(std::to_string(i));
+		}
+		EXPECT(vec.size() == std::size_t(elements));
+		EXPECT(vec[std::size_t(elements - 1)] == std::to_string(elements - 1));
+
+		auto copy = vec;
+		EXPECT(copy.size() == vec.size());
+		EXPECT(std::equal(std::begin(copy), std::end(copy), std::begin(vec)));
+
+		// heap elements are stolen, inline ones are moved
+		const auto data = vec.data();
+		auto moved = std::move(vec);
+		EXPECT(moved.data() == data);
+		EXPECT(vec.empty());
+		EXPECT(!vec.is_heap());
+
+		dyno::small_vector<std::string, 4> small;
+		small.emplace_back("inline");
+		vec = std::move(small);
+		EXPECT(!vec.is_heap());
+		EXPECT(vec.size() == 1);
+		EXPECT(vec[0] == "inline");
+		EXPECT(small.empty());
+
+		const auto capacity = moved.capacity();
+		moved.clear();
+		EXPECT(moved.empty());
+		EXPECT(moved.capacity() == capacity);
+	};
+}
+
+template <typename Archive, typename OArchive>
+using storage_expression = decltype(Archive::get_storage(std::declval<OArchive>()));
+
+void test_anystream_storage(const std::string& test)
+{
+	using archive_t = dyno::archive<dyno::anystream, dyno::anystream>;
+
+	TEST_CASE(test + " inline storage")
+	{
+		auto oarchive = archive_t::create_oarchive();
+		const auto before = allocation_count();
+		archive_t::pack(oarchive, 1, 2.0, 'c');
+		const auto storage = archive_t::get_storage(std::move(oarchive));
+		const auto inline_allocations = allocation_count() - before;
+		EXPECT(!storage.is_heap());
+		// at most what every any costs, never the storage
+		EXPECT(inline_allocations <= storage.size());
+
+		// external storage, as used by object_rep::get
+		auto iarchive = archive_t::create_iarchive(storage);
+		EXPECT(iarchive.has_external_storage());
+		int i{};
+		double d{};
+		char c{};
+		EXPECT(archive_t::unpack(iarchive, i) && i == 1);
+		const double* ref = nullptr;
+		const int* wrong = nullptr;
+		EXPECT(!archive_t::unpack_ref(iarchive, wrong));
+		EXPECT(archive_t::unpack_ref(iarchive, ref) && ref == hpp::any_cast<double>(&storage[1]));
+		archive_t::rewind(iarchive);
+		EXPECT(archive_t::unpack(iarchive, i) && i == 1);
+		auto copy = iarchive;
+		EXPECT(!copy.has_external_storage());
+		EXPECT(archive_t::unpack(iarchive, d) && d == 2.0);
+		EXPECT(archive_t::unpack(iarchive, c) && c == 'c');
+		EXPECT(!archive_t::unpack(iarchive, c));
+
+		// the copy owns the values and starts over
+		auto moved = std::move(copy);
+		EXPECT(archive_t::unpack(moved, i) && i == 1);
+		EXPECT(moved.internal_storage.size() == 3);
+	};
+
+	TEST_CASE(test + " spilled storage")
+	{
+		auto oarchive = archive_t::create_oarchive();
+		archive_t::pack(oarchive, 1, 2, 3, 4, 5, 6);
+		auto iarchive = archive_t::create_iarchive(std::move(oarchive));
+		EXPECT(iarchive.internal_storage.is_heap());
+
+		int sum = 0;
+		for(int i = 0; i < 6; ++i)
+		{
+			int value{};
+			EXPECT(archive_t::unpack(iarchive, value));
+			sum += value;
+		}
+		EXPECT(sum == 21);
+
+		// the heap buffer is picked up by the next pack needing one
+		const auto data = iarchive.internal_storage.data();
+		archive_t::recycle(std::move(iarchive));
+		auto small = archive_t::create_oarchive();
+		archive_t::pack(small, 1);
+		EXPECT(!small.internal_storage.is_heap());
+		auto large = archive_t::create_oarchive();
+		archive_t::pack(large, 1, 2, 3, 4, 5, 6);
+		EXPECT(large.internal_storage.data() == data);
+	};
+
+	TEST_CASE(test + " borrowed arguments")
+	{
+		const std::string str("on_tick");
+		const short value = 42;
+		auto oarchive = archive_t::create_borrowed_oarchive();
+		archive_t::pack_borrowed(oarchive, str, value);
+		auto iarchive = archive_t::create_iarchive(std::move(oarchive));
+		EXPECT(iarchive.is_borrowed());
+		EXPECT(iarchive.internal_storage.empty());
+
+		// read in place when the types match, converted otherwise
+		const std::string* ref = nullptr;
+		EXPECT(archive_t::unpack_ref(iarchive, ref) && ref == &str);
+		const int* wrong = nullptr;
+		EXPECT(!archive_t::unpack_ref(iarchive, wrong) && wrong == nullptr);
+		int converted{};
+		EXPECT(archive_t::unpack(iarchive, converted) && converted == 42);
+		EXPECT(!archive_t::unpack(iarchive, converted));
+
+		archive_t::rewind(iarchive);
+		std::string copy;
+		EXPECT(archive_t::unpack(iarchive, copy) && copy == str);
+
+		// the addresses would not outlive the dispatch
+		static_assert(!hpp::is_detected<storage_expression, archive_t, archive_t::borrowed_oarchive_t>::value,
+					  "borrowed archives must not be storable");
+		static_assert(hpp::is_detected<storage_expression, archive_t, archive_t::oarchive_t>::value,
+					  "archives must be storable");
+	};
+}
+
+void test_dense_map(const std::string& test, int keys)
+{
+	TEST_CASE(test + ", keys=" + std::to_string(keys))
+	{
+		dyno::dense_map<int, int> map;
+		for(int i = 0; i < keys; i += 2)
+		{
+			EXPECT(map.emplace(i, i).second);
+		}
+		EXPECT(map.size() == size_t(keys / 2));
+		EXPECT(!map.emplace(0, -1).second);
+		EXPECT(map.find(1) == std::end(map));
+		EXPECT(map.find(keys * 2) == std::end(map));
+
+		// negative keys are out of range, not a huge allocation
+		EXPECT(map.find(-1) == std::end(map));
+		EXPECT_THROWS(map.emplace(-1, 0));
+
+		for(int i = 1; i < keys; i += 2)
+		{
+			map.emplace(i, i);
+		}
+		EXPECT(map.erase(keys / 2) == 1);
+		EXPECT(map.erase(keys / 2) == 0);
+
+		int sum = 0;
+		int previous = -1;
+		bool ordered = true;
+		for(const auto& kvp : map)
+		{
+			ordered &= kvp.first > previous;
+			previous = kvp.first;
+			sum += kvp.second;
+		}
+		EXPECT(ordered);
+		EXPECT(sum == keys * (keys - 1) / 2 - keys / 2);
+
+		auto copy = map;
+		EXPECT(copy.size() == map.size());
+		EXPECT(copy.find(keys - 1)->second == keys - 1);
+	};
+
+	TEST_CASE(test + " narrow signed keys")
+	{
+		// -1 is not mistaken for index 65535 or 255
+		dyno::dense_map<signed_event, int> map;
+		EXPECT(map.emplace(signed_event::last, 1).second);
+		EXPECT_THROWS(map.emplace(signed_event::invalid, 0));
+		EXPECT(map.find(signed_event::invalid) == std::end(map));
+		EXPECT(map.size() == 1);
+
+		dyno::dense_map<std::int8_t, int> small;
+		EXPECT_THROWS(small.emplace(std::int8_t(-1), 0));
+		EXPECT(small.find(std::int8_t(-1)) == std::end(small));
+		EXPECT(small.empty());
+
+		// a key past the cap throws instead of allocating the whole range
+		dyno::dense_map<std::int64_t, int> wide;
+		EXPECT_THROWS(wide.emplace(std::int64_t(1) << 40, 0));
+		EXPECT(wide.emplace(std::int64_t(dyno::default_dense_map_max_size - 1), 0).second);
+	};
+
+	TEST_CASE(test + " only with dense_binder_traits")
+	{
+		// the default traits keep negative and sparse integral keys
+		dyno::binder<dyno::anystream, dyno::anystream, int> binder;
+		int sum = 0;
+		binder.connect(-1, [&sum](int i) { sum += i; });
+		binder.connect(100000000, [&sum](int i) { sum += i * 10; });
+		binder.dispatch(-1, 1);
+		binder.dispatch(100000000, 1);
+		EXPECT(sum == 11);
+
+		dyno::binder<dyno::anystream, dyno::anystream, int, int, std::weak_ptr<void>,
+					 dyno::dense_binder_traits>
+			dense;
+		EXPECT_THROWS(dense.connect(-1, [](int) {}));
+		// keys the table cannot hold are dropped by process_queue
+		int queued = 0;
+		dense.connect(1, [&queued](int i) { queued += i; });
+		dense.enqueue(-1, 1);
+		dense.enqueue(1, 1);
+		dense.enqueue(100000000, 1);
+		dense.enqueue(-1, 1);
+		EXPECT(dense.process_queue() == 4);
+		EXPECT(queued == 1);
+
+		dyno::binder<dyno::anystream, dyno::anystream, signed_event, signed_event, std::weak_ptr<void>,
+					 dyno::dense_binder_traits>
+			signed_dense;
+		EXPECT_THROWS(signed_dense.connect(signed_event::invalid, [](int) {}));
+		signed_dense.dispatch(signed_event::invalid, 1);
+	};
+}
+
 int main()
 {
 
@@ -196,21 +2240,126 @@ int main()
 	{
 		using binder = dyno::binder<dyno::anystream, dyno::anystream, std::string>;
 		test_binder<binder>("any binder string", calls, slots);
+		test_binder_handles<binder>("any binder string", calls, slots);
+		test_binder_typed<binder>("any binder string", slots);
+		test_binder_moves<binder>("any binder string");
+		test_binder_priority<binder>("any binder string", calls * 10, slots);
+		test_binder_disconnect<binder>("any binder string", calls * 10, slots);
+		test_binder_queue<binder>("any binder string", calls * 10, slots);
+		test_binder_dispatch_many<binder>("any binder string", calls * 10, slots);
+		test_binder_wildcards<binder>("any binder string", calls * 10, slots);
+		test_binder_wildcard_cache("any binder string", calls * 100);
+		test_binder_allocations<binder>("any binder string literal", "plugin_on_system_ready");
+		test_binder_allocations<binder>("any binder string string_view",
+										hpp::string_view("plugin_on_system_ready"));
+		test_binder_archive_allocations<binder>("any binder string");
+		// the payload is borrowed, neither copied nor held by an any
+		test_binder_payload_allocations<binder>("any binder string", calls * 100, 0);
 
 		using object_rep = dyno::object_rep<dyno::anystream, dyno::anystream, std::string>;
 		using object = dyno::object<object_rep>;
 		test_object<object>("any object string", calls);
+
+		test_anystream_conversions("anystream", calls * 10000);
+		test_anystream_storage("anystream");
+		test_small_vector("small_vector", 100);
+	}
+
+	{
+		using anystream = dyno::basic_anystream<4, dyno::basic_any<48>>;
+		using binder = dyno::binder<anystream, anystream, std::string>;
+		test_binder<binder>("sbo any binder string", calls, slots);
+		test_binder_typed<binder>("sbo any binder string", slots);
+		test_binder_moves<binder>("sbo any binder string");
+		test_binder_payload_allocations<binder>("sbo any binder string", calls * 100, 0);
+
+		using object_rep = dyno::object_rep<anystream, anystream, std::string>;
+		using object = dyno::object<object_rep>;
+		test_object<object>("sbo any object string", calls);
+		test_move_only<binder, object>("sbo any");
+
+		test_any("any");
 	}
 
 	{
 		using binder = dyno::binder<dyno::anystream, dyno::anystream, std::string, hpp::string_view>;
 		test_binder<binder>("any binder string_view", calls, slots);
+		test_binder_handles<binder>("any binder string_view", calls, slots);
+		test_binder_allocations<binder>("any binder string_view", "plugin_on_system_ready");
 
 		using object_rep = dyno::object_rep<dyno::anystream, dyno::anystream, std::string, hpp::string_view>;
 		using object = dyno::object<object_rep>;
 		test_object<object>("any object string_view", calls);
 	}
 
+	{
+		using binder = dyno::binder<dyno::anystream, dyno::anystream, std::string, hpp::string_view,
+									std::weak_ptr<void>, dyno::flat_binder_traits>;
+		test_binder<binder>("any flat binder string_view", calls, slots);
+		test_binder_handles<binder>("any flat binder string_view", calls, slots);
+		test_binder_queue<binder>("any flat binder string_view", calls * 10, slots);
+		test_binder_dispatch_many<binder>("any flat binder string_view", calls * 10, slots);
+		test_binder_wildcards<binder>("any flat binder string_view", calls * 10, slots);
+		test_binder_allocations<binder>("any flat binder string_view", "plugin_on_system_ready");
+
+		test_flat_hash_map("flat_hash_map", 1000);
+	}
+
+	{
+		using binder = dyno::binder<dyno::anystream, dyno::anystream, plugin_event>;
+		test_binder_dense<binder>("any binder enum", calls, slots);
+		test_binder_allocations<binder>("any binder enum", plugin_event::frame_end);
+
+		using flat_binder = dyno::binder<dyno::anystream, dyno::anystream, plugin_event, plugin_event,
+										 std::weak_ptr<void>, dyno::flat_binder_traits>;
+		test_binder_dense<flat_binder>("any flat binder enum", calls, slots);
+
+		using dense_binder = dyno::binder<dyno::anystream, dyno::anystream, plugin_event, plugin_event,
+										  std::weak_ptr<void>, dyno::dense_binder_traits>;
+		test_binder_dense<dense_binder>("any dense binder enum", calls, slots);
+		test_binder_allocations<dense_binder>("any dense binder enum", plugin_event::frame_end);
+
+		test_dense_map("dense_map", 1000);
+	}
+
+	{
+		using binder = dyno::binder<dyno::anystream, dyno::anystream, dyno::hashed_key>;
+		test_binder<binder>("any binder hashed_key", calls, slots);
+		test_binder_handles<binder>("any binder hashed_key", calls, slots);
+		test_binder_allocations<binder>("any binder hashed_key", dyno::hashed_key("plugin_on_system_ready"));
+		test_binder_allocations<binder>("any binder hashed_key string", std::string("plugin_on_system_ready"));
+
+		using flat_binder = dyno::binder<dyno::anystream, dyno::anystream, dyno::hashed_key, dyno::hashed_key,
+										 std::weak_ptr<void>, dyno::flat_binder_traits>;
+		test_binder<flat_binder>("any flat binder hashed_key", calls, slots);
+
+		test_hashed_key("hashed_key");
+	}
+
+	{
+		using binder = dyno::binder<dyno::anystream, dyno::anystream, std::string, std::string,
+									std::weak_ptr<void>, std_function_binder_traits>;
+		test_binder<binder>("any std::function binder string", calls, slots);
+
+		test_delegate("inplace_delegate");
+	}
+
+	{
+		using binder = dyno::binder<dyno::anystream, dyno::anystream, std::string>;
+		using concurrent_binder = dyno::concurrent_binder<dyno::anystream, dyno::anystream, std::string>;
+		test_concurrent_binder<concurrent_binder>("any concurrent binder string");
+		test_binder_moves<concurrent_binder>("any concurrent binder string");
+
+		std::mutex mutex;
+		test_binder_contention<binder>("any binder string behind a mutex", calls * 1000, slots / 10, &mutex);
+		test_binder_contention<concurrent_binder>("any concurrent binder string", calls * 1000, slots / 10,
+												  nullptr);
+
+		test_event_inbox<binder>("any binder string inbox", calls * 1000, 4);
+		test_binder_parallel<binder>("any binder string", calls, slots);
+		test_binder_async<binder>("any binder string", calls * 10);
+	}
+
 	{
 		using object_rep = dyno::object_rep<nlohmann::json, nlohmann::json, std::string, hpp::string_view>;
 		using object = dyno::object<object_rep>;